@@ -24,82 +24,786 @@
 
 #include "utils.h"
 #include "select_size.h"
+#include <stddef.h>
+#include <cstring>
+#include <atomic>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <algorithm>
 
-template<int SIZE, class DATA_T = unsigned char>
-class CircularBuffer
+namespace Mcucpp
 {
+	namespace Ring
+	{
+		//Plain volatile indices, enough for an ISR and the main loop on a single core.
+		//The elements are not volatile, so the other side's index is read before a compiler
+		//acquire fence and an index is published after a release fence.
+		struct VolatileIndex
+		{
+			template<typename INDEX_T>
+			class Indices
+			{
+			private:
+				volatile INDEX_T _readCount;
+				volatile INDEX_T _writeCount;
+
+				static INDEX_T Acquire(const volatile INDEX_T& index)
+				{
+					const INDEX_T value = index;
+					AcquireFence();
+					return value;
+				}
+				static void Release(volatile INDEX_T& index, INDEX_T value)
+				{
+					ReleaseFence();
+					index = value;
+				}
+			public:
+				INDEX_T ReadIndex() const { return _readCount; }
+				INDEX_T WriteIndex() const { return _writeCount; }
+				INDEX_T AcquireReadIndex() const { return Acquire(_readCount); }
+				INDEX_T AcquireWriteIndex() const { return Acquire(_writeCount); }
+				INDEX_T CachedReadIndex() const { return Acquire(_readCount); }
+				INDEX_T CachedWriteIndex() const { return Acquire(_writeCount); }
+				INDEX_T RefreshReadIndex() { return Acquire(_readCount); }
+				INDEX_T RefreshWriteIndex() { return Acquire(_writeCount); }
+				void PublishReadIndex(INDEX_T value) { Release(_readCount, value); }
+				void PublishWriteIndex(INDEX_T value) { Release(_writeCount, value); }
+				void Reset()
+				{
+					_readCount = 0;
+					_writeCount = 0;
+				}
+			};
+			static void AcquireFence() { std::atomic_signal_fence(std::memory_order_acquire); }
+			static void ReleaseFence() { std::atomic_signal_fence(std::memory_order_release); }
+		};
+
+		//Lock-free SPSC indices for multi-core targets and host threads.
+		//Each side owns a cache line with its index and a local copy of the other side's index,
+		//the shared line is only touched when the local copy runs out of data/space.
+		template<size_t CacheLine = 64>
+		struct AtomicIndex
+		{
+			template<typename INDEX_T>
+			class Indices
+			{
+			private:
+				alignas(CacheLine) std::atomic<INDEX_T> _writeCount;
+				INDEX_T _cachedReadCount;		//producer local
+				alignas(CacheLine) std::atomic<INDEX_T> _readCount;
+				INDEX_T _cachedWriteCount;		//consumer local
+			public:
+				INDEX_T ReadIndex() const { return _readCount.load(std::memory_order_relaxed); }
+				INDEX_T WriteIndex() const { return _writeCount.load(std::memory_order_relaxed); }
+				INDEX_T AcquireReadIndex() const { return _readCount.load(std::memory_order_acquire); }
+				INDEX_T AcquireWriteIndex() const { return _writeCount.load(std::memory_order_acquire); }
+				INDEX_T CachedReadIndex() const { return _cachedReadCount; }
+				INDEX_T CachedWriteIndex() const { return _cachedWriteCount; }
+				INDEX_T RefreshReadIndex()
+				{
+					return _cachedReadCount = _readCount.load(std::memory_order_acquire);
+				}
+				INDEX_T RefreshWriteIndex()
+				{
+					return _cachedWriteCount = _writeCount.load(std::memory_order_acquire);
+				}
+				void PublishReadIndex(INDEX_T value) { _readCount.store(value, std::memory_order_release); }
+				void PublishWriteIndex(INDEX_T value) { _writeCount.store(value, std::memory_order_release); }
+				void Reset()
+				{
+					_cachedReadCount = _cachedWriteCount = 0;
+					_readCount.store(0, std::memory_order_relaxed);
+					_writeCount.store(0, std::memory_order_relaxed);
+				}
+			};
+			static void AcquireFence() { std::atomic_thread_fence(std::memory_order_acquire); }
+			static void ReleaseFence() { std::atomic_thread_fence(std::memory_order_release); }
+		};
+
+		//Write fails when the buffer is full
+		struct DiscardNew
+		{
+			enum { overwrite = false };
+			class State
+			{
+			protected:
+				void Claim(unsigned) { }
+				unsigned Claimed() const { return 0; }
+				void AddLost(unsigned) { }
+				uint32_t LostCount() const { return 0; }
+				void ResetState() { }
+			};
+		};
+
+		//Flight recorder: newest data wins, the oldest entries are overwritten.
+		//Indices run freely over the native word so the reader can tell how far it was lapped.
+		struct OverwriteOld
+		{
+			enum { overwrite = true };
+			class State
+			{
+			private:
+				std::atomic<unsigned> _claimCount;	//written up to, published before the data is touched
+				uint32_t _lostCount;				//reader side
+			protected:
+				void Claim(unsigned value) { _claimCount.store(value, std::memory_order_relaxed); }
+				unsigned Claimed() const { return _claimCount.load(std::memory_order_relaxed); }
+				void AddLost(unsigned n) { _lostCount += n; }
+				uint32_t LostCount() const { return _lostCount; }
+				void ResetState()
+				{
+					_claimCount.store(0, std::memory_order_relaxed);
+					_lostCount = 0;
+				}
+			};
+		};
+
+		//No instrumentation
+		struct NoStats
+		{
+			enum { enabled = false };
+			class State
+			{
+			protected:
+				void OnWrite(size_t, size_t) { }
+				void OnOverflow(size_t) { }
+				void OnUnderflow() { }
+				void ClearStats() { }
+			};
+		};
+
+		//Occupancy instrumentation: high-water mark, rejected writes, empty reads, elements passed through.
+		//Every counter is written by its owning side only, ResetStats() bumps a request number
+		//that the owner applies on its next operation, so a reset never races with an update.
+		struct TrackStats
+		{
+			enum { enabled = true };
+			class State
+			{
+			private:
+				std::atomic<uint8_t> _resetRequest;
+				uint8_t _producerReset;
+				uint8_t _consumerReset;
+				std::atomic<uint32_t> _highWater;	//producer side
+				std::atomic<uint32_t> _overflows;
+				std::atomic<uint32_t> _throughput;
+				std::atomic<uint32_t> _underflows;	//consumer side
+
+				static void Add(std::atomic<uint32_t>& counter, uint32_t n)
+				{
+					counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+				}
+				void SyncProducer()
+				{
+					const uint8_t request = _resetRequest.load(std::memory_order_relaxed);
+					if(_producerReset != request)
+					{
+						_producerReset = request;
+						_highWater.store(0, std::memory_order_relaxed);
+						_overflows.store(0, std::memory_order_relaxed);
+						_throughput.store(0, std::memory_order_relaxed);
+					}
+				}
+				uint32_t Get(const std::atomic<uint32_t>& counter, uint8_t ownerReset) const
+				{
+					return ownerReset == _resetRequest.load(std::memory_order_relaxed) ?
+								counter.load(std::memory_order_relaxed) : 0;
+				}
+			protected:
+				void OnWrite(size_t n, size_t count)
+				{
+					SyncProducer();
+					Add(_throughput, n);
+					if(count > _highWater.load(std::memory_order_relaxed))
+						_highWater.store(count, std::memory_order_relaxed);
+				}
+				void OnOverflow(size_t n)
+				{
+					SyncProducer();
+					Add(_overflows, n);
+				}
+				void OnUnderflow()
+				{
+					const uint8_t request = _resetRequest.load(std::memory_order_relaxed);
+					if(_consumerReset != request)
+					{
+						_consumerReset = request;
+						_underflows.store(0, std::memory_order_relaxed);
+					}
+					Add(_underflows, 1);
+				}
+				void ClearStats()
+				{
+					_resetRequest.store(0, std::memory_order_relaxed);
+					_producerReset = _consumerReset = 0;
+					_highWater.store(0, std::memory_order_relaxed);
+					_overflows.store(0, std::memory_order_relaxed);
+					_throughput.store(0, std::memory_order_relaxed);
+					_underflows.store(0, std::memory_order_relaxed);
+				}
+			public:
+				uint32_t HighWater() const { return Get(_highWater, _producerReset); }
+				uint32_t Overflows() const { return Get(_overflows, _producerReset); }
+				uint32_t Underflows() const { return Get(_underflows, _consumerReset); }
+				uint32_t Throughput() const { return Get(_throughput, _producerReset); }
+				void ResetStats()
+				{
+					_resetRequest.store(_resetRequest.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+				}
+			};
+		};
+
+		namespace Private
+		{
+			template<int SIZE, class Overflow>
+			struct IndexType
+			{
+				typedef typename StaticIf<Overflow::overwrite,
+						unsigned,
+						typename SelectSizeForLength<2 * SIZE - 1>::type>::type type;
+			};
+
+			//Uninitialized element storage, indices and index arithmetic
+			template<int SIZE, class DATA_T, class Sync, class Overflow,
+					 bool = std::is_trivially_copyable<DATA_T>::value>
+			class RingStorage
+			{
+			protected:
+				typedef typename IndexType<SIZE, Overflow>::type INDEX_T;
+				static const bool _pow2 = (SIZE&(SIZE - 1)) == 0;
+				static const INDEX_T _mask = SIZE - 1;
+				typename std::aligned_storage<sizeof(DATA_T), alignof(DATA_T)>::type _data[SIZE];
+				typename Sync::template Indices<INDEX_T> _idx;
+
+				//Power of 2 sizes use free running indices and a mask,
+				//other sizes keep indices in [0, 2 * SIZE) and wrap them with a compare
+				static size_t Position(INDEX_T index)
+				{
+					if(_pow2)
+						return index & _mask;
+					return index < SIZE ? index : index - SIZE;
+				}
+				static INDEX_T Advance(INDEX_T index, size_t n)
+				{
+					if(_pow2)
+						return index + (INDEX_T)n;
+					const size_t result = index + n;
+					return result < 2 * SIZE ? result : result - 2 * SIZE;
+				}
+				static size_t Distance(INDEX_T to, INDEX_T from)
+				{
+					if(_pow2)
+						return (INDEX_T)(to - from);
+					return to >= from ? to - from : to + 2 * SIZE - from;
+				}
+				DATA_T* Slot(size_t pos)
+				{
+					return reinterpret_cast<DATA_T*>(&_data[pos]);
+				}
+				const DATA_T* Slot(size_t pos) const
+				{
+					return reinterpret_cast<const DATA_T*>(&_data[pos]);
+				}
+				void Destroy(INDEX_T from, size_t n)
+				{
+					if(std::is_trivially_destructible<DATA_T>::value)
+						return;
+					size_t pos = Position(from);
+					while(n--)
+					{
+						Slot(pos)->~DATA_T();
+						if(++pos == SIZE)
+							pos = 0;
+					}
+				}
+			};
+
+			//Live elements are destroyed with the buffer, so the indices must start out valid,
+			//and a copy constructs its own elements instead of sharing the raw bytes.
+			//Trivially copyable types keep trivial construction, copy and destruction.
+			template<int SIZE, class DATA_T, class Sync, class Overflow>
+			class RingStorage<SIZE, DATA_T, Sync, Overflow, false> : public RingStorage<SIZE, DATA_T, Sync, Overflow, true>
+			{
+			private:
+				void DestroyAll()
+				{
+					const typename RingStorage::INDEX_T readCount = this->_idx.ReadIndex();
+					this->Destroy(readCount, this->Distance(this->_idx.WriteIndex(), readCount));
+				}
+				//The live range of other is copied to the start of the empty storage
+				void CopyFrom(const RingStorage& other)
+				{
+					const typename RingStorage::INDEX_T readCount = other._idx.ReadIndex();
+					const size_t count = this->Distance(other._idx.WriteIndex(), readCount);
+					size_t pos = this->Position(readCount);
+					for(size_t i = 0; i < count; ++i)
+					{
+						new(this->Slot(i)) DATA_T(*other.Slot(pos));
+						if(++pos == SIZE)
+							pos = 0;
+					}
+					this->_idx.PublishWriteIndex(this->Advance(0, count));
+				}
+			public:
+				RingStorage()
+				{
+					this->_idx.Reset();
+				}
+				RingStorage(const RingStorage& other)
+				{
+					this->_idx.Reset();
+					CopyFrom(other);
+				}
+				RingStorage& operator=(const RingStorage& other)
+				{
+					if(this != &other)
+					{
+						DestroyAll();
+						this->_idx.Reset();
+						CopyFrom(other);
+					}
+					return *this;
+				}
+				~RingStorage()
+				{
+					DestroyAll();
+				}
+			};
+		}
+	}
+}
+
+template<int SIZE, class DATA_T = unsigned char, class Sync = Mcucpp::Ring::VolatileIndex,
+		 class Overflow = Mcucpp::Ring::DiscardNew, class Stats = Mcucpp::Ring::NoStats>
+class CircularBuffer : public Stats::State, private Overflow::State,
+		private Mcucpp::Ring::Private::RingStorage<SIZE, DATA_T, Sync, Overflow>
+{
+private:
+	typedef Mcucpp::Ring::Private::RingStorage<SIZE, DATA_T, Sync, Overflow> Base;
 public:
-	typedef typename Mcucpp::SelectSizeForLength<SIZE>::type INDEX_T;
+	typedef typename Base::INDEX_T INDEX_T;
 
 private:
-	STATIC_ASSERT((SIZE&(SIZE - 1)) == 0);//SIZE must be a power of 2
-	DATA_T _data[SIZE];
-	volatile INDEX_T _readCount;
-	volatile INDEX_T _writeCount;
-	static const INDEX_T _mask = SIZE - 1;
+	using Base::_pow2;
+	using Base::_mask;
+	using Base::_idx;
+	using Base::Position;
+	using Base::Advance;
+	using Base::Distance;
+	using Base::Slot;
+	using Base::Destroy;
+	static const bool _trivial = std::is_trivially_copyable<DATA_T>::value;
+	STATIC_ASSERT(SIZE > 0);
+	STATIC_ASSERT(!Overflow::overwrite || _pow2);//overwrite mode needs free running indices
+	STATIC_ASSERT(!Overflow::overwrite || SIZE <= (INDEX_T)~0U / 2);
+	STATIC_ASSERT(!Overflow::overwrite || _trivial);//the reader copies out slots the writer may be overwriting
+
+	//Producer side, the read index is reloaded only if the cached one shows too little space
+	size_t FreeSpace(INDEX_T writeCount, size_t wanted)
+	{
+		size_t free = SIZE - Distance(writeCount, _idx.CachedReadIndex());
+		if(free < wanted)
+			free = SIZE - Distance(writeCount, _idx.RefreshReadIndex());
+		return free;
+	}
+	//Occupancy after a write for the stats. The cached read index can lag the consumer by
+	//the whole buffer, so a fresh one is loaded, and only when stats are enabled.
+	size_t Occupancy(INDEX_T writeCount) const
+	{
+		return Stats::enabled ? Distance(writeCount, _idx.AcquireReadIndex()) : 0;
+	}
+	//Consumer side
+	size_t Available(INDEX_T readCount, size_t wanted)
+	{
+		size_t count = Distance(_idx.CachedWriteIndex(), readCount);
+		if(count < wanted)
+			count = Distance(_idx.RefreshWriteIndex(), readCount);
+		return count;
+	}
+
+	//Copy constructs into raw storage
+	static void Copy(DATA_T* dst, const DATA_T* src, size_t length, Mcucpp::Int2Type<true>)
+	{
+		memcpy(dst, src, length * sizeof(DATA_T));
+	}
+	static void Copy(DATA_T* dst, const DATA_T* src, size_t length, Mcucpp::Int2Type<false>)
+	{
+		for(size_t i = 0; i < length; ++i)
+			new(dst + i) DATA_T(src[i]);
+	}
+	static void Copy(DATA_T* dst, const DATA_T* src, size_t length)
+	{
+		Copy(dst, src, length, Mcucpp::Int2Type<_trivial>());
+	}
+	//Moves out of live slots and destroys them
+	static void MoveOut(DATA_T* dst, DATA_T* src, size_t length, Mcucpp::Int2Type<true>)
+	{
+		memcpy(dst, src, length * sizeof(DATA_T));
+	}
+	static void MoveOut(DATA_T* dst, DATA_T* src, size_t length, Mcucpp::Int2Type<false>)
+	{
+		for(size_t i = 0; i < length; ++i)
+		{
+			dst[i] = std::move(src[i]);
+			src[i].~DATA_T();
+		}
+	}
+	static void MoveOut(DATA_T* dst, DATA_T* src, size_t length)
+	{
+		MoveOut(dst, src, length, Mcucpp::Int2Type<_trivial>());
+	}
+
+	//Overwrite mode paths, tag dispatched so that other modes do not instantiate them
+	typedef Mcucpp::Int2Type<Overflow::overwrite> OverwriteTag;
+	size_t WriteOverwrite(const DATA_T*, size_t, Mcucpp::Int2Type<false>)
+	{
+		return 0;
+	}
+	size_t ReadOverwrite(DATA_T*, size_t, Mcucpp::Int2Type<false>)
+	{
+		return 0;
+	}
+
+#if (defined(__SSE2__) || defined(__ARM_NEON)) && !defined(MCUCPP_NO_SIMD)
+	//Host libcs have a vectorized memchr
+	static const DATA_T* Search(const DATA_T* begin, size_t length, DATA_T value, Mcucpp::Int2Type<true>)
+	{
+		return (const DATA_T*)memchr(begin, (uint8_t)value, length);
+	}
+#else
+	typedef size_t Word;
+#ifdef __GNUC__
+	typedef Word __attribute__((may_alias)) AliasWord;
+#endif
+	static Word LoadWord(const uint8_t* ptr)
+	{
+#ifdef __GNUC__
+		return *(const AliasWord*)ptr;
+#else
+		Word w;
+		memcpy(&w, ptr, sizeof(w));
+		return w;
+#endif
+	}
+	//newlib-nano's memchr is a byte loop. A word at a time here: XOR with the byte
+	//repeated makes matches zero bytes. Only aligned words inside the region are loaded
+	static const DATA_T* Search(const DATA_T* begin, size_t length, DATA_T value, Mcucpp::Int2Type<true>)
+	{
+		const Word ones = (Word)~(Word)0 / 0xFF;
+		const Word highs = ones * 0x80;
+		const uint8_t byte = (uint8_t)value;
+		const uint8_t* ptr = (const uint8_t*)begin;
+		const uint8_t* const end = ptr + length;
+		for(; ptr != end && ((uintptr_t)ptr & (sizeof(Word) - 1)); ++ptr)
+			if(*ptr == byte)
+				return (const DATA_T*)ptr;
+		const Word pattern = ones * byte;
+		for(; (size_t)(end - ptr) >= sizeof(Word); ptr += sizeof(Word))
+		{
+			const Word w = LoadWord(ptr) ^ pattern;
+			if((w - ones) & ~w & highs)
+				break;	//the match is in this word
+		}
+		for(; ptr != end; ++ptr)
+			if(*ptr == byte)
+				return (const DATA_T*)ptr;
+		return nullptr;
+	}
+#endif
+	static const DATA_T* Search(const DATA_T* begin, size_t length, const DATA_T& value, Mcucpp::Int2Type<false>)
+	{
+		const DATA_T* end = begin + length;
+		const DATA_T* result = std::find(begin, end, value);
+		return result == end ? nullptr : result;
+	}
+	static const DATA_T* Search(const DATA_T* begin, size_t length, const DATA_T& value)
+	{
+		return Search(begin, length, value, Mcucpp::Int2Type<sizeof(DATA_T) == 1 && _trivial>());
+	}
+
+	size_t WriteOverwrite(const DATA_T* src, size_t length, Mcucpp::Int2Type<true>)
+	{
+		const INDEX_T writeCount = _idx.WriteIndex();
+		const INDEX_T newCount = writeCount + (INDEX_T)length;
+		const size_t skip = length > SIZE ? length - SIZE : 0;	//only the newest SIZE elements survive
+		this->Claim(newCount);
+		Sync::ReleaseFence();
+		const size_t pos = (writeCount + skip) & _mask;
+		length -= skip;
+		const size_t first = (SIZE - pos) < length ? (SIZE - pos) : length;
+		Copy(Slot(pos), src + skip, first);
+		Copy(Slot(0), src + skip + first, length - first);
+		_idx.PublishWriteIndex(newCount);
+		this->OnWrite(length + skip, 0);	//occupancy is unknown to the writer in this mode
+		return length + skip;
+	}
+
+	//Copies out and then checks that the writer has not claimed the copied slots meanwhile
+	size_t ReadOverwrite(DATA_T* dst, size_t length, Mcucpp::Int2Type<true>)
+	{
+		INDEX_T readCount = _idx.ReadIndex();
+		for(;;)
+		{
+			INDEX_T count = _idx.AcquireWriteIndex() - readCount;
+			if(count > SIZE)
+			{
+				this->AddLost(count - SIZE);
+				readCount += count - SIZE;
+				count = SIZE;
+			}
+			const size_t n = length < count ? length : count;
+			const size_t pos = readCount & _mask;
+			const size_t first = (SIZE - pos) < n ? (SIZE - pos) : n;
+			Copy(dst, Slot(pos), first);
+			Copy(dst + first, Slot(0), n - first);
+			Sync::AcquireFence();
+			const INDEX_T overrun = this->Claimed() - readCount;
+			if(overrun <= SIZE)
+			{
+				_idx.PublishReadIndex(readCount + (INDEX_T)n);
+				if(!n)
+					this->OnUnderflow();
+				return n;
+			}
+			this->AddLost(overrun - SIZE);
+			readCount += overrun - SIZE;
+		}
+	}
 public:
 
-	bool Write(DATA_T value)
+	//Constructs the element in place
+	template<typename... Args>
+	bool Emplace(Args&&... args)
 	{
-		if(IsFull())
+		if(Overflow::overwrite)
+		{
+			const DATA_T value(std::forward<Args>(args)...);
+			return WriteOverwrite(&value, 1, OverwriteTag());
+		}
+		const INDEX_T writeCount = _idx.WriteIndex();
+		const size_t free = FreeSpace(writeCount, 1);
+		if(!free)
+		{
+			this->OnOverflow(1);
 			return 0;
-		_data[_writeCount++ & _mask] = value;
+		}
+		new(Slot(Position(writeCount))) DATA_T(std::forward<Args>(args)...);
+		const INDEX_T newCount = Advance(writeCount, 1);
+		_idx.PublishWriteIndex(newCount);
+		this->OnWrite(1, Occupancy(newCount));
 		return true;
 	}
 
+	//By value, so a volatile register can be passed straight from an ISR
+	bool Write(DATA_T value)
+	{
+		return Emplace(std::move(value));
+	}
+
+	//Moves the element out
 	bool Read(DATA_T &value)
 	{
-		if(IsEmpty())
+		if(Overflow::overwrite)
+			return ReadOverwrite(&value, 1, OverwriteTag());
+		const INDEX_T readCount = _idx.ReadIndex();
+		if(!Available(readCount, 1))
+		{
+			this->OnUnderflow();
 			return 0;
-		value = _data[_readCount++ & _mask];
+		}
+		MoveOut(&value, Slot(Position(readCount)), 1);
+		_idx.PublishReadIndex(Advance(readCount, 1));
 		return true;
 	}
 
-	DATA_T First()const
+	//Bulk write, returns number of elements actually written
+	size_t Write(const DATA_T* src, size_t length)
+	{
+		if(Overflow::overwrite)
+			return WriteOverwrite(src, length, OverwriteTag());
+		const INDEX_T writeCount = _idx.WriteIndex();
+		const size_t free = FreeSpace(writeCount, length);
+		if(length > free)
+		{
+			this->OnOverflow(length - free);
+			length = free;
+		}
+		const size_t pos = Position(writeCount);
+		const size_t first = (SIZE - pos) < length ? (SIZE - pos) : length;
+		Copy(Slot(pos), src, first);
+		Copy(Slot(0), src + first, length - first);
+		const INDEX_T newCount = Advance(writeCount, length);
+		_idx.PublishWriteIndex(newCount);
+		this->OnWrite(length, Occupancy(newCount));
+		return length;
+	}
+
+	//Bulk read, returns number of elements actually read
+	size_t Read(DATA_T* dst, size_t length)
+	{
+		if(Overflow::overwrite)
+			return ReadOverwrite(dst, length, OverwriteTag());
+		const INDEX_T readCount = _idx.ReadIndex();
+		const size_t count = Available(readCount, length);
+		if(!count)
+			this->OnUnderflow();
+		if(length > count)
+			length = count;
+		const size_t pos = Position(readCount);
+		const size_t first = (SIZE - pos) < length ? (SIZE - pos) : length;
+		MoveOut(dst, Slot(pos), first);
+		MoveOut(dst + first, Slot(0), length - first);
+		_idx.PublishReadIndex(Advance(readCount, length));
+		return length;
+	}
+
+	//Largest contiguous free region, fill it and call Commit()
+	DATA_T* Reserve(size_t& length)
+	{
+		STATIC_ASSERT(_trivial);//the region is raw storage
+		const INDEX_T writeCount = _idx.WriteIndex();
+		const size_t pos = Position(writeCount);
+		if(Overflow::overwrite)
+		{
+			length = SIZE - pos;
+			this->Claim(writeCount + (INDEX_T)length);
+			Sync::ReleaseFence();
+			return Slot(pos);
+		}
+		const size_t free = FreeSpace(writeCount, SIZE - pos);
+		length = (SIZE - pos) < free ? (SIZE - pos) : free;
+		return Slot(pos);
+	}
+
+	void Commit(size_t length)
+	{
+		const INDEX_T writeCount = Advance(_idx.WriteIndex(), length);
+		if(Overflow::overwrite)
+			this->Claim(writeCount);
+		_idx.PublishWriteIndex(writeCount);
+		if(Stats::enabled)
+			this->OnWrite(length, Overflow::overwrite ? 0 : Occupancy(writeCount));
+	}
+
+	//Largest contiguous readable region, process it and call Consume()
+	const DATA_T* Peek(size_t& length)
+	{
+		STATIC_ASSERT(!Overflow::overwrite);//the writer may overwrite the region, use Read()
+		const INDEX_T readCount = _idx.ReadIndex();
+		const size_t pos = Position(readCount);
+		const size_t count = Available(readCount, SIZE - pos);
+		length = (SIZE - pos) < count ? (SIZE - pos) : count;
+		return Slot(pos);
+	}
+
+	void Consume(size_t length)
+	{
+		const INDEX_T readCount = _idx.ReadIndex();
+		Destroy(readCount, length);
+		_idx.PublishReadIndex(Advance(readCount, length));
+	}
+
+	//Offset of the first delim from the read position
+	bool Find(const DATA_T& delim, size_t& position)
+	{
+		STATIC_ASSERT(!Overflow::overwrite);
+		const INDEX_T readCount = _idx.ReadIndex();
+		const size_t count = Available(readCount, SIZE);
+		const size_t pos = Position(readCount);
+		const size_t first = (SIZE - pos) < count ? (SIZE - pos) : count;
+		const DATA_T* found = Search(Slot(pos), first, delim);
+		if(found)
+		{
+			position = found - Slot(pos);
+			return true;
+		}
+		found = Search(Slot(0), count - first, delim);
+		if(found)
+		{
+			position = first + (found - Slot(0));
+			return true;
+		}
+		return false;
+	}
+
+	//Reads a complete frame including delim, returns 0 while it is incomplete.
+	//A frame longer than maxLength, or a full buffer without delim, is returned in maxLength pieces.
+	size_t ReadUntil(const DATA_T& delim, DATA_T* dst, size_t maxLength)
+	{
+		size_t position;
+		if(Find(delim, position))
+			return Read(dst, position < maxLength ? position + 1 : maxLength);
+		const size_t count = Count();
+		if(count == SIZE || count >= maxLength)
+			return Read(dst, maxLength);
+		return 0;
+	}
+
+	//Element access requires i < Count()
+	const DATA_T& First()const
 	{
 		return operator[](0);
 	}
 
-	DATA_T Last()const
+	const DATA_T& Last()const
 	{
-		return operator[](Count());
+		return operator[](Count() - 1);
 	}
 
 	DATA_T& operator[] (INDEX_T i)
 	{
-		if(IsEmpty() || i > Count())
-			return DATA_T();
-		return _data[(_readCount + i) & _mask];
+		return *Slot(Position(Advance(_idx.ReadIndex(), i)));
 	}
 
-	const DATA_T operator[] (INDEX_T i) const
+	const DATA_T& operator[] (INDEX_T i) const
 	{
-		if(IsEmpty() || i > Count())
-			return DATA_T();
-		return _data[(_readCount + i) & _mask];
+		return *Slot(Position(Advance(_idx.ReadIndex(), i)));
 	}
 
 	bool IsEmpty()const
 	{
-		INDEX_T temp = _readCount;
-		return _writeCount == temp;
+		INDEX_T temp = _idx.AcquireReadIndex();
+		return _idx.AcquireWriteIndex() == temp;
 	}
 
 	bool IsFull()const
 	{
-		INDEX_T temp = _readCount;
-		return ((_writeCount - temp) & (INDEX_T)~(_mask)) != 0;
+		if(Overflow::overwrite)
+			return Count() == SIZE;
+		INDEX_T temp = _idx.AcquireReadIndex();
+		return Distance(_idx.AcquireWriteIndex(), temp) == SIZE;
 	}
 
 	INDEX_T Count()const
 	{
-		return (_writeCount - _readCount) & _mask;
+		INDEX_T temp = _idx.AcquireReadIndex();
+		if(Overflow::overwrite)
+		{
+			temp = _idx.AcquireWriteIndex() - temp;
+			return temp > SIZE ? SIZE : temp;
+		}
+		return Distance(_idx.AcquireWriteIndex(), temp);
 	}
 
 	void Clear()
 	{
-		_readCount = 0;
-		_writeCount = 0;
+		if(!std::is_trivially_destructible<DATA_T>::value)
+		{
+			const INDEX_T readCount = _idx.ReadIndex();
+			Destroy(readCount, Distance(_idx.WriteIndex(), readCount));
+		}
+		_idx.Reset();
+		this->ResetState();
+		this->ClearStats();
+	}
+
+	//Entries overwritten before the reader got them
+	uint32_t Lost()const
+	{
+		STATIC_ASSERT(Overflow::overwrite);
+		return this->LostCount();
 	}
 
 	unsigned Size()
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef DEFERREDLOG_H
+#define DEFERREDLOG_H
+
+#include "format.h"
+
+//Deferred logging: a record is the 32-bit ID of the format string followed by the raw
+//little-endian arguments, the text is rebuilt on the host by tools/logdecode.py.
+//	Io::DeferredLog log(Log::Write);
+//	IO_LOG(log, "T=%5d H=%x\r\n", t, h);
+//The ID is a compile-time hash of the format string, so it doesn't depend on where the
+//string lands: inline functions, templates, LTO and PIE host builds all decode the same.
+//The assembler copies the string to the .mcucpp_log section, which is not allocated and
+//takes no flash, a section attribute would be ignored or conflict in inline code.
+//n strings share an ID with odds of about n^2 / 2^33, 1e-5 for 300 strings. The decoder
+//warns about such a pair and fails only on records carrying the shared ID.
+//Escapes in the string are limited to those gas knows: \n \r \t \\ \" octal and hex.
+//Specifiers are those of Io::Format without %s: d, u, x, b take 4 bytes, c takes 1.
+#define IO_LOG(log, str, ...) do { \
+		__asm__(".pushsection .mcucpp_log,\"\"\n\t.ascii " MCUCPP_LOG_STR(str) "\n\t.byte 0\n\t.popsection"); \
+		struct FormatString_ { static constexpr const char* Get() { return str; } }; \
+		(log).template Record<FormatString_>(__VA_ARGS__); \
+	} while(0)
+#define MCUCPP_LOG_STR(str) #str
+
+namespace Mcucpp {
+	namespace Io {
+		namespace Internal {
+
+			//FNV-1a, tools/logdecode.py computes the same
+			constexpr uint32_t LogHash(const char* s, uint32_t hash = 2166136261u)
+			{
+				return *s ? LogHash(s + 1, (hash ^ (uint8_t)*s) * 16777619u) : hash;
+			}
+			template<typename Str>
+			struct LogId
+			{
+				enum : uint32_t { value = LogHash(Str::Get()) };
+			};
+
+			template<char conv>
+			struct LogArg
+			{
+				static constexpr size_t size = 0;
+				template<typename T>
+				static uint8_t* Store(uint8_t* ptr, T)
+				{
+					static_assert(conv != conv, "format specifier not supported in deferred logs");
+					return ptr;
+				}
+			};
+			template<>
+			struct LogArg<'d'>
+			{
+				static constexpr size_t size = 4;
+				template<typename T>
+				static uint8_t* Store(uint8_t* ptr, T value)
+				{
+					ArgCheck<'d', T>();
+					const int32_t v = value;
+					memcpy(ptr, &v, size);
+					return ptr + size;
+				}
+			};
+			template<char conv>
+			struct UnsignedLogArg
+			{
+				static constexpr size_t size = 4;
+				template<typename T>
+				static uint8_t* Store(uint8_t* ptr, T value)
+				{
+					ArgCheck<conv, T>();
+					const uint32_t v = (typename std::make_unsigned<T>::type)value;
+					memcpy(ptr, &v, size);
+					return ptr + size;
+				}
+			};
+			template<> struct LogArg<'u'> : UnsignedLogArg<'u'> { };
+			template<> struct LogArg<'x'> : UnsignedLogArg<'x'> { };
+			template<> struct LogArg<'b'> : UnsignedLogArg<'b'> { };
+			template<>
+			struct LogArg<'c'>
+			{
+				static constexpr size_t size = 1;
+				template<typename T>
+				static uint8_t* Store(uint8_t* ptr, T value)
+				{
+					ArgCheck<'c', T>();
+					*ptr = value;
+					return ptr + size;
+				}
+			};
+
+			//Same walk as FormatStep, literals are skipped and only the argument bytes are stored
+			template<typename Str, size_t pos, Token = TokenAt(Str::Get(), pos)>
+			struct LogStep;
+
+			template<typename Str, size_t pos>
+			struct LogStep<Str, pos, Token::End>
+			{
+				static constexpr size_t size = 0;
+				template<typename... Args>
+				static void Store(uint8_t*, Args...)
+				{
+					static_assert(sizeof...(Args) == 0, "too many arguments for the format string");
+				}
+			};
+			template<typename Str, size_t pos>
+			struct LogStep<Str, pos, Token::Literal> : LogStep<Str, LiteralEnd(Str::Get(), pos)>
+			{ };
+			template<typename Str, size_t pos>
+			struct LogStep<Str, pos, Token::Percent> : LogStep<Str, pos + 2>
+			{ };
+			template<typename Str, size_t pos>
+			struct LogStep<Str, pos, Token::Spec>
+			{
+				enum
+				{
+					convPos = DigitsEnd(Str::Get(), FlagsEnd(Str::Get(), pos + 1)),
+					conv = Str::Get()[convPos]
+				};
+				static_assert(conv != '\0', "incomplete format specifier");
+				typedef LogStep<Str, convPos + 1> Next;
+				static constexpr size_t size = LogArg<(char)conv>::size + Next::size;
+
+				template<typename T, typename... Args>
+				static void Store(uint8_t* ptr, T arg, Args... args)
+				{
+					Next::Store(LogArg<(char)conv>::Store(ptr, arg), args...);
+				}
+				template<typename... Args>
+				static void Store(uint8_t*, Args...)
+				{
+					static_assert(sizeof...(Args) != 0, "too few arguments for the format string");
+				}
+			};
+		}//Internal
+
+		//Sends every record with a single call, so a Drop policy on the sink loses whole records only
+		class DeferredLog
+		{
+		private:
+			void (*const Write_)(const uint8_t*, size_t);
+		public:
+			static constexpr size_t IdSize = 4;
+
+			DeferredLog(writefunc_t Write) : Write_(&Write)
+			{	}
+			//Use IO_LOG, it stores the format string and fills in Str
+			template<typename Str, typename... Args>
+			void Record(Args... args)
+			{
+				uint8_t record[IdSize + Internal::LogStep<Str, 0>::size];
+				const uint32_t id = Internal::LogId<Str>::value;
+				memcpy(record, &id, IdSize);
+				Internal::LogStep<Str, 0>::Store(record + IdSize, args...);
+				Write_(record, sizeof(record));
+			}
+		};
+
+	}//IO
+}//Mcucpp
+
+#endif // DEFERREDLOG_H
@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef FORMAT_H
+#define FORMAT_H
+
+#include "streams.h"
+
+//Format strings parsed at compile time:
+//	Io::Format(os, IO_FMT("T=%5d H=%x\r\n"), t, h);		//C++11
+//	Io::Format<"T=%5d H=%x\r\n">(os, t, h);				//C++20
+//Specifier: %[-][0][width]conv, conv is one of
+//	d - signed decimal, u - unsigned decimal, x - hex, b - binary, c - char, s - string, %% - percent sign
+//Argument count and types are checked against the string, the stream's width/adjust/system state is not used
+
+//Wraps a string literal into a type usable as a template argument
+#define IO_FMT(str) ([]{ struct FormatString_ { static constexpr const char* Get() { return str; } }; return FormatString_(); }())
+
+namespace Mcucpp {
+	namespace Io {
+		namespace Internal {
+
+			struct FormatEmitter
+			{
+				static void Puts(Ostream& os, const char* str, size_t length)
+				{
+					os.Puts((const uint8_t*)str, length);
+				}
+				static void Putc(Ostream& os, uint8_t ch)
+				{
+					os.Putc(ch);
+				}
+				static void Field(Ostream& os, const char* prefix, uint8_t prefixLength, const uint8_t* str, uint8_t length,
+								uint8_t width, bool left, bool zero)
+				{
+					os.PutField(prefix, prefixLength, str, length, width, left ? Io::left : right, zero ? '0' : ' ');
+				}
+				static void Flush(Ostream& os)
+				{
+					os.Flush();
+				}
+			};
+
+			enum class Token { End, Literal, Percent, Spec };
+
+			constexpr Token TokenAt(const char* s, size_t i)
+			{
+				return s[i] == '\0' ? Token::End :
+						s[i] != '%' ? Token::Literal :
+						s[i + 1] == '%' ? Token::Percent : Token::Spec;
+			}
+			constexpr size_t LiteralEnd(const char* s, size_t i)
+			{
+				return s[i] == '\0' || s[i] == '%' ? i : LiteralEnd(s, i + 1);
+			}
+			constexpr size_t FlagsEnd(const char* s, size_t i)
+			{
+				return s[i] == '-' || s[i] == '0' ? FlagsEnd(s, i + 1) : i;
+			}
+			constexpr bool HasFlag(const char* s, size_t i, size_t end, char flag)
+			{
+				return i < end && (s[i] == flag || HasFlag(s, i + 1, end, flag));
+			}
+			constexpr size_t DigitsEnd(const char* s, size_t i)
+			{
+				return s[i] >= '0' && s[i] <= '9' ? DigitsEnd(s, i + 1) : i;
+			}
+			constexpr uint32_t ParseNumber(const char* s, size_t i, uint32_t acc)
+			{
+				return s[i] >= '0' && s[i] <= '9' ? ParseNumber(s, i + 1, acc * 10 + s[i] - '0') : acc;
+			}
+
+			//Argument type rules per specifier, instantiating it fails on a mismatch
+			template<char conv, typename T>
+			struct ArgCheck
+			{
+				static_assert(conv != conv, "unknown format specifier");
+			};
+			template<typename T>
+			struct ArgCheck<'d', T>
+			{
+				static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value
+							&& sizeof(T) <= 4 && (std::is_signed<T>::value || sizeof(T) < 4),
+							"%d expects an integer convertible to int32_t");
+			};
+			template<typename T>
+			struct ArgCheck<'u', T>
+			{
+				static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value
+							&& std::is_unsigned<T>::value && sizeof(T) <= 4,
+							"%u expects an unsigned integer up to 32 bits");
+			};
+			template<typename T>
+			struct ArgCheck<'x', T>
+			{
+				static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 4,
+							"%x and %b expect an integer up to 32 bits");
+			};
+			template<typename T>
+			struct ArgCheck<'b', T> : ArgCheck<'x', T>
+			{ };
+			template<typename T>
+			struct ArgCheck<'c', T>
+			{
+				static_assert(std::is_same<T, char>::value || std::is_same<T, signed char>::value
+							|| std::is_same<T, unsigned char>::value, "%c expects a character");
+			};
+			template<typename T>
+			struct ArgCheck<'s', T>
+			{
+				static_assert(std::is_pointer<T>::value && sizeof(typename std::remove_pointer<T>::type) == 1
+							&& std::is_integral<typename std::remove_pointer<T>::type>::value, "%s expects a character string");
+			};
+
+			//Conversion for a single argument, selected by the specifier letter
+			template<char conv>
+			struct Conversion
+			{
+				template<typename T>
+				static void Put(Ostream&, T, uint8_t, bool, bool)
+				{
+					ArgCheck<conv, T>();
+				}
+			};
+			template<>
+			struct Conversion<'d'>
+			{
+				template<typename T>
+				static void Put(Ostream& os, T value, uint8_t width, bool left, bool zero)
+				{
+					ArgCheck<'d', T>();
+					const int32_t v = value;
+					uint8_t buf[10];
+					const uint8_t* str = Utoa10(v < 0 ? 0U - (uint32_t)v : (uint32_t)v, buf + sizeof(buf));
+					FormatEmitter::Field(os, "-", v < 0, str, buf + sizeof(buf) - str, width, left, zero);
+				}
+			};
+			template<>
+			struct Conversion<'u'>
+			{
+				template<typename T>
+				static void Put(Ostream& os, T value, uint8_t width, bool left, bool zero)
+				{
+					ArgCheck<'u', T>();
+					uint8_t buf[10];
+					const uint8_t* str = Utoa10(value, buf + sizeof(buf));
+					FormatEmitter::Field(os, "", 0, str, buf + sizeof(buf) - str, width, left, zero);
+				}
+			};
+			template<uint8_t shift>
+			struct PowerOfTwoConversion
+			{
+				template<typename T>
+				static void Put(Ostream& os, T value, uint8_t width, bool left, bool zero)
+				{
+					ArgCheck<'x', T>();
+					uint8_t buf[32];
+					//Bit pattern of the argument's own width, not of the promoted int
+					const uint8_t* str = UtoaPow2<shift>((typename std::make_unsigned<T>::type)value, buf + sizeof(buf));
+					FormatEmitter::Field(os, "", 0, str, buf + sizeof(buf) - str, width, left, zero);
+				}
+			};
+			template<> struct Conversion<'x'> : PowerOfTwoConversion<4> { };
+			template<> struct Conversion<'b'> : PowerOfTwoConversion<1> { };
+			template<>
+			struct Conversion<'c'>
+			{
+				template<typename T>
+				static void Put(Ostream& os, T value, uint8_t width, bool left, bool)
+				{
+					ArgCheck<'c', T>();
+					const uint8_t ch = value;
+					FormatEmitter::Field(os, "", 0, &ch, 1, width, left, false);
+				}
+			};
+			template<>
+			struct Conversion<'s'>
+			{
+				template<typename T>
+				static void Put(Ostream& os, T* str, uint8_t width, bool left, bool)
+				{
+					ArgCheck<'s', T*>();
+					const size_t length = strlen((const char*)str);
+					if(length >= width)
+						FormatEmitter::Puts(os, (const char*)str, length);
+					else
+						FormatEmitter::Field(os, "", 0, (const uint8_t*)str, length, width, left, false);
+				}
+				template<typename T>
+				static void Put(Ostream&, T, uint8_t, bool, bool)
+				{
+					ArgCheck<'s', T>();
+				}
+			};
+
+			template<typename Str, size_t pos, Token = TokenAt(Str::Get(), pos)>
+			struct FormatStep;
+
+			template<typename Str, size_t pos>
+			struct FormatStep<Str, pos, Token::End>
+			{
+				template<typename... Args>
+				static void Run(Ostream& os, Args...)
+				{
+					static_assert(sizeof...(Args) == 0, "too many arguments for the format string");
+					FormatEmitter::Flush(os);
+				}
+			};
+			template<typename Str, size_t pos>
+			struct FormatStep<Str, pos, Token::Literal>
+			{
+				enum { end = LiteralEnd(Str::Get(), pos) };
+				template<typename... Args>
+				static void Run(Ostream& os, Args... args)
+				{
+					FormatEmitter::Puts(os, Str::Get() + pos, end - pos);
+					FormatStep<Str, end>::Run(os, args...);
+				}
+			};
+			template<typename Str, size_t pos>
+			struct FormatStep<Str, pos, Token::Percent>
+			{
+				template<typename... Args>
+				static void Run(Ostream& os, Args... args)
+				{
+					FormatEmitter::Putc(os, '%');
+					FormatStep<Str, pos + 2>::Run(os, args...);
+				}
+			};
+			template<typename Str, size_t pos>
+			struct FormatStep<Str, pos, Token::Spec>
+			{
+				enum
+				{
+					flagsEnd = FlagsEnd(Str::Get(), pos + 1),
+					left = HasFlag(Str::Get(), pos + 1, flagsEnd, '-'),
+					zero = HasFlag(Str::Get(), pos + 1, flagsEnd, '0') && !left,
+					width = ParseNumber(Str::Get(), flagsEnd, 0),
+					convPos = DigitsEnd(Str::Get(), flagsEnd),
+					conv = Str::Get()[convPos]
+				};
+				static_assert(conv != '\0', "incomplete format specifier");
+				static_assert(width < 256, "format field width is limited to 255");
+
+				template<typename T, typename... Args>
+				static void Run(Ostream& os, T arg, Args... args)
+				{
+					Conversion<(char)conv>::Put(os, arg, width, left, zero);
+					FormatStep<Str, convPos + 1>::Run(os, args...);
+				}
+				template<typename... Args>
+				static void Run(Ostream&, Args...)
+				{
+					static_assert(sizeof...(Args) != 0, "too few arguments for the format string");
+				}
+			};
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+			template<size_t N>
+			struct FixedString
+			{
+				char data[N] {};
+				constexpr FixedString(const char (&str)[N])
+				{
+					for(size_t i = 0; i < N; ++i)
+						data[i] = str[i];
+				}
+			};
+			template<FixedString str>
+			struct LiteralString
+			{
+				static constexpr const char* Get()
+				{
+					return str.data;
+				}
+			};
+#endif
+		}//Internal
+
+		//Str is a type with static constexpr Get() returning the format string, see IO_FMT
+		template<typename Str, typename... Args>
+		inline Ostream& Format(Ostream& os, Str, Args... args)
+		{
+			Internal::FormatStep<Str, 0>::Run(os, args...);
+			return os;
+		}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+		template<Internal::FixedString str, typename... Args>
+		inline Ostream& Format(Ostream& os, Args... args)
+		{
+			Internal::FormatStep<Internal::LiteralString<str>, 0>::Run(os, args...);
+			return os;
+		}
+#endif
+
+	}//IO
+}//Mcucpp
+
+#endif // FORMAT_H
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+
+#include "utils.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+//Bounded multi-producer/multi-consumer queue, per-slot sequence numbers, no locks.
+//Interface follows CircularBuffer. Relies on lock-free compare-and-swap, so not for ARMv6-M.
+template<int SIZE, class DATA_T = unsigned char, size_t CacheLine = 64>
+class MpmcQueue
+{
+private:
+	STATIC_ASSERT((SIZE&(SIZE - 1)) == 0);//SIZE must be a power of 2
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		DATA_T data;
+	};
+	Cell _data[SIZE];
+	alignas(CacheLine) std::atomic<size_t> _writeCount;
+	alignas(CacheLine) std::atomic<size_t> _readCount;
+	static const size_t _mask = SIZE - 1;
+public:
+	MpmcQueue()
+	{
+		Clear();
+	}
+
+	bool Write(DATA_T value)
+	{
+		Cell* cell;
+		size_t pos = _writeCount.load(std::memory_order_relaxed);
+		for(;;)
+		{
+			cell = &_data[pos & _mask];
+			const intptr_t diff = (intptr_t)cell->sequence.load(std::memory_order_acquire) - (intptr_t)pos;
+			if(diff == 0)
+			{
+				if(_writeCount.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if(diff < 0)
+				return false;	//full
+			else
+				pos = _writeCount.load(std::memory_order_relaxed);
+		}
+		cell->data = value;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	bool Read(DATA_T &value)
+	{
+		Cell* cell;
+		size_t pos = _readCount.load(std::memory_order_relaxed);
+		for(;;)
+		{
+			cell = &_data[pos & _mask];
+			const intptr_t diff = (intptr_t)cell->sequence.load(std::memory_order_acquire) - (intptr_t)(pos + 1);
+			if(diff == 0)
+			{
+				if(_readCount.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else if(diff < 0)
+				return false;	//empty
+			else
+				pos = _readCount.load(std::memory_order_relaxed);
+		}
+		value = cell->data;
+		cell->sequence.store(pos + SIZE, std::memory_order_release);
+		return true;
+	}
+
+	//Approximate when other threads are active
+	size_t Count()const
+	{
+		const size_t readCount = _readCount.load(std::memory_order_acquire);
+		const size_t count = _writeCount.load(std::memory_order_acquire) - readCount;
+		return (intptr_t)count < 0 ? 0 : (count > SIZE ? SIZE : count);
+	}
+
+	bool IsEmpty()const
+	{
+		return Count() == 0;
+	}
+
+	bool IsFull()const
+	{
+		return Count() == SIZE;
+	}
+
+	//Not thread safe
+	void Clear()
+	{
+		for(size_t i = 0; i < SIZE; ++i)
+			_data[i].sequence.store(i, std::memory_order_relaxed);
+		_readCount.store(0, std::memory_order_relaxed);
+		_writeCount.store(0, std::memory_order_relaxed);
+	}
+
+	unsigned Size()
+	{
+		return SIZE;
+	}
+};
@@ -24,65 +24,290 @@
 #ifndef PINLIST_H
 #define PINLIST_H
 
+#include <type_traits>
+#include "select_size.h"
 #include "gpio.h"
 
 namespace Mcucpp {
 	namespace Gpio {
 		namespace Private {
 
-		template<typename...>
-		struct PinlistImplementation;
+		template<uint16_t NofPins, typename T = typename SelectSize<NofPins>::type>
+		struct NumberToMask
+		{
+			static constexpr T value = NofPins < sizeof(T) * 8 ? (T)(((T)1 << NofPins % (sizeof(T) * 8)) - 1) : (T)~(T)0;
+		};
 
-		template<typename First, typename... Rest>
-		struct PinlistImplementation<First, Rest...>
+		template<typename... Ts>
+		struct TypeList
+		{ };
+
+		template<typename T, typename List>
+		struct Prepend;
+		template<typename T, typename... Ts>
+		struct Prepend<T, TypeList<Ts...>>
 		{
-			template<uint32_t pos = 0>
-			static uint32_t ReadODR()
-			{
-				return ((uint32_t)First::IsSetODR() << pos) | PinlistImplementation<Rest...>::template ReadODR<pos + 1>();
-			}
-			template<uint32_t pos = 0>
-			static uint32_t Read()
+			using type = TypeList<T, Ts...>;
+		};
+
+		template<typename T, typename List>
+		struct Contains;
+		template<typename T>
+		struct Contains<T, TypeList<>>
+		{
+			enum { value = false };
+		};
+		template<typename T, typename First, typename... Rest>
+		struct Contains<T, TypeList<First, Rest...>>
+		{
+			enum { value = std::is_same<T, First>::value || Contains<T, TypeList<Rest...>>::value };
+		};
+
+		//Pin bound to its bit in the Pinlist value
+		template<typename P, uint32_t bit>
+		struct IndexedPin
+		{
+			using Pin = P;
+			using Port = typename Pin::Port;
+			enum
 			{
-				return ((uint32_t)First::IsSet() << pos) | PinlistImplementation<Rest...>::template Read<pos + 1>();
-			}
-			static void Write(uint32_t value)
+				position = Pin::position,
+				index = bit,
+				delta = (int)Pin::position - (int)bit
+			};
+		};
+
+		template<uint32_t index, typename... Pins>
+		struct IndexPins
+		{
+			using type = TypeList<>;
+		};
+		template<uint32_t index, typename First, typename... Rest>
+		struct IndexPins<index, First, Rest...>
+		{
+			using type = typename Prepend<IndexedPin<First, index>, typename IndexPins<index + 1, Rest...>::type>::type;
+		};
+
+		//Distinct ports of a list of IndexedPin
+		template<typename Pins>
+		struct UniquePorts;
+		template<>
+		struct UniquePorts<TypeList<>>
+		{
+			using type = TypeList<>;
+		};
+		template<typename First, typename... Rest>
+		struct UniquePorts<TypeList<First, Rest...>>
+		{
+			using Tail = typename UniquePorts<TypeList<Rest...>>::type;
+			using type = typename std::conditional<Contains<typename First::Port, Tail>::value,
+						Tail, typename Prepend<typename First::Port, Tail>::type>::type;
+		};
+
+		template<typename Port, typename Pins>
+		struct PinsOfPort;
+		template<typename Port>
+		struct PinsOfPort<Port, TypeList<>>
+		{
+			using type = TypeList<>;
+		};
+		template<typename Port, typename First, typename... Rest>
+		struct PinsOfPort<Port, TypeList<First, Rest...>>
+		{
+			using Tail = typename PinsOfPort<Port, TypeList<Rest...>>::type;
+			using type = typename std::conditional<std::is_same<Port, typename First::Port>::value,
+						typename Prepend<First, Tail>::type, Tail>::type;
+		};
+
+		template<typename Pins>
+		struct MinIndex;
+		template<typename Last>
+		struct MinIndex<TypeList<Last>>
+		{
+			enum { value = Last::index };
+		};
+		template<typename First, typename Second, typename... Rest>
+		struct MinIndex<TypeList<First, Second, Rest...>>
+		{
+			enum { value = (uint32_t)First::index < (uint32_t)MinIndex<TypeList<Second, Rest...>>::value
+						? (uint32_t)First::index : (uint32_t)MinIndex<TypeList<Second, Rest...>>::value };
+		};
+		template<typename Pins>
+		struct MaxIndex;
+		template<typename Last>
+		struct MaxIndex<TypeList<Last>>
+		{
+			enum { value = Last::index };
+		};
+		template<typename First, typename Second, typename... Rest>
+		struct MaxIndex<TypeList<First, Second, Rest...>>
+		{
+			enum { value = (uint32_t)First::index > (uint32_t)MaxIndex<TypeList<Second, Rest...>>::value
+						? (uint32_t)First::index : (uint32_t)MaxIndex<TypeList<Second, Rest...>>::value };
+		};
+
+		//Value bits counted from base
+		template<uint32_t base, typename Pins>
+		struct Rebase;
+		template<uint32_t base, typename... Pins>
+		struct Rebase<base, TypeList<Pins...>>
+		{
+			using type = TypeList<IndexedPin<typename Pins::Pin, Pins::index - base>...>;
+		};
+
+		template<typename Pins>
+		struct PortMask;
+		template<>
+		struct PortMask<TypeList<>>
+		{
+			enum { value = 0 };
+		};
+		template<typename First, typename... Rest>
+		struct PortMask<TypeList<First, Rest...>>
+		{
+			enum { value = 1UL << First::position | PortMask<TypeList<Rest...>>::value };
+		};
+
+		template<int shift, bool left = (shift >= 0)>
+		struct Shift
+		{
+			template<typename T>
+			static T Apply(T value)
+			{ return value << shift; }
+		};
+		template<int shift>
+		struct Shift<shift, false>
+		{
+			template<typename T>
+			static T Apply(T value)
+			{ return value >> -shift; }
+		};
+
+		template<int d>
+		struct Delta
+		{
+			enum { value = d };
+		};
+
+		template<typename Pins>
+		struct UniqueDeltas;
+		template<>
+		struct UniqueDeltas<TypeList<>>
+		{
+			using type = TypeList<>;
+		};
+		template<typename First, typename... Rest>
+		struct UniqueDeltas<TypeList<First, Rest...>>
+		{
+			using Tail = typename UniqueDeltas<TypeList<Rest...>>::type;
+			using type = typename std::conditional<Contains<Delta<First::delta>, Tail>::value,
+						Tail, typename Prepend<Delta<First::delta>, Tail>::type>::type;
+		};
+
+		template<int delta, typename Pins>
+		struct PinsWithDelta;
+		template<int delta>
+		struct PinsWithDelta<delta, TypeList<>>
+		{
+			using type = TypeList<>;
+		};
+		template<int delta, typename First, typename... Rest>
+		struct PinsWithDelta<delta, TypeList<First, Rest...>>
+		{
+			using Tail = typename PinsWithDelta<delta, TypeList<Rest...>>::type;
+			using type = typename std::conditional<First::delta == delta,
+						typename Prepend<First, Tail>::type, Tail>::type;
+		};
+
+		//Bit permutation between the value and one port, like a software PDEP/PEXT:
+		//all pins with the same position - index distance move with a single shift and mask,
+		//so runs of consecutive pins, and runs repeating the same offset, cost one step each
+		template<typename Deltas, typename Pins, typename Acc>
+		struct DeltaGroups;
+		template<typename Pins, typename Acc>
+		struct DeltaGroups<TypeList<>, Pins, Acc>
+		{
+			static uint32_t Scatter(Acc)
+			{ return 0; }
+			static Acc Gather(uint32_t)
+			{ return 0; }
+		};
+		template<typename D, typename... Ds, typename Pins, typename Acc>
+		struct DeltaGroups<TypeList<D, Ds...>, Pins, Acc>
+		{
+			enum { mask = PortMask<typename PinsWithDelta<D::value, Pins>::type>::value };
+			using Next = DeltaGroups<TypeList<Ds...>, Pins, Acc>;
+			static uint32_t Scatter(Acc value)
 			{
-				First::SetOrClear(value & 0x01);
-				PinlistImplementation<Rest...>::Write(value >> 1);
+				return ((uint32_t)Shift<D::value>::Apply(value) & mask) | Next::Scatter(value);
 			}
-			template<OutputConf conf, OutputMode mode>
-			static void SetConfig()
+			static Acc Gather(uint32_t portValue)
 			{
-				First::template SetConfig<conf, mode>();
-				PinlistImplementation<Rest...>::template SetConfig<conf, mode>();
+				return Shift<-D::value>::Apply((Acc)(portValue & mask)) | Next::Gather(portValue);
 			}
 		};
 
-		template<>
-		struct PinlistImplementation<>
+		//One register access per port for Write, Read and ReadODR, one configuration per port.
+		//The value bits of a port are first brought down to a 32-bit word, so wide lists pay
+		//for a single wide shift per port and lists up to 32 pins never touch 64-bit arithmetic
+		template<typename Ports, typename Pins, typename T>
+		struct PortGroups;
+		template<typename Pins, typename T>
+		struct PortGroups<TypeList<>, Pins, T>
 		{
-			template<uint32_t pos>
-			static uint32_t ReadODR()
+			static void Write(T){}
+			static T Read()
 			{ return 0; }
-			template<uint32_t pos>
-			static uint32_t Read()
+			static T ReadODR()
 			{ return 0; }
-			static void Write(uint32_t){}
 			template<OutputConf conf, OutputMode mode>
 			static void SetConfig(){}
+			template<InputConf conf, InputMode mode>
+			static void SetConfig(){}
 		};
-
-		template<uint16_t NofPins>
-		struct NumberToMask
-		{
-			enum { value = 1 << (NofPins - 1) | NumberToMask<NofPins - 1>::value};
-		};
-
-		template<>
-		struct NumberToMask<0>
+		template<typename Port, typename... Ports, typename Pins, typename T>
+		struct PortGroups<TypeList<Port, Ports...>, Pins, T>
 		{
-			enum { value = 0 };
+			using Group = typename PinsOfPort<Port, Pins>::type;
+			enum
+			{
+				mask = PortMask<Group>::value,
+				narrow = MaxIndex<Group>::value - MinIndex<Group>::value < 32,
+				base = narrow ? (uint32_t)MinIndex<Group>::value : 0
+			};
+			using Acc = typename std::conditional<narrow, uint32_t, T>::type;
+			using Local = typename Rebase<base, Group>::type;
+			using Layout = DeltaGroups<typename UniqueDeltas<Local>::type, Local, Acc>;
+			using Next = PortGroups<TypeList<Ports...>, Pins, T>;
+			static void Write(T value)
+			{
+				const uint32_t bits = Layout::Scatter((Acc)(value >> base));
+				Port::ClearAndSet(~bits & mask, bits);
+				Next::Write(value);
+			}
+			//Each port register is sampled once and all of them back to back, bits are gathered afterwards
+			static T Read()
+			{
+				const uint32_t sample = Port::Read();
+				return Next::Read() | (T)((T)Layout::Gather(sample) << base);
+			}
+			static T ReadODR()
+			{
+				const uint32_t sample = Port::ReadODR();
+				return Next::ReadODR() | (T)((T)Layout::Gather(sample) << base);
+			}
+			template<OutputConf conf, OutputMode mode>
+			static void SetConfig()
+			{
+				Port::template SetConfig<mask, conf, mode>();
+				Next::template SetConfig<conf, mode>();
+			}
+			template<InputConf conf, InputMode mode>
+			static void SetConfig()
+			{
+				Port::template SetConfig<mask, conf, mode>();
+				Next::template SetConfig<conf, mode>();
+			}
 		};
 
 		}//Private
@@ -93,54 +318,65 @@ namespace Mcucpp {
 			enum { value = seq };
 		};
 
+		//Pins are grouped by port at compile time, Write stores each port once and
+		//value bits move in shift-and-mask groups, see DeltaGroups.
+		//Up to 64 pins, value_type is the smallest unsigned type holding all of them
 		template<typename First, typename... Rest>
 		struct Pinlist
 		{
-			static uint32_t ReadODR()
+			static_assert(sizeof...(Rest) < 64, "Pinlist holds up to 64 pins");
+			using value_type = typename SelectSize<sizeof...(Rest) + 1>::type;
+		private:
+			using Pins = typename Private::IndexPins<0, First, Rest...>::type;
+			using Ports = typename Private::UniquePorts<Pins>::type;
+			using Groups = Private::PortGroups<Ports, Pins, value_type>;
+		public:
+			static value_type ReadODR()
 			{
-				return Private::PinlistImplementation<First, Rest...>::template ReadODR<>();
+				return Groups::ReadODR();
 			}
-			static uint32_t Read()
+			static value_type Read()
 			{
-				return Private::PinlistImplementation<First, Rest...>::template Read<>();
+				return Groups::Read();
 			}
-			static void Write(uint32_t value)
+			static void Write(value_type value)
 			{
-				Private::PinlistImplementation<First, Rest...>::Write(value);
+				Groups::Write(value);
 			}
 			template<OutputConf conf, OutputMode mode>
 			static void SetConfig()
 			{
-				Private::PinlistImplementation<First, Rest...>::template SetConfig<conf, mode>();
+				Groups::template SetConfig<conf, mode>();
 			}
 			template<InputConf conf, InputMode mode>
 			static void SetConfig()
 			{
-				Private::PinlistImplementation<First, Rest...>::template SetConfig<conf, mode>();
+				Groups::template SetConfig<conf, mode>();
 			}
 		};
 
 		template<typename First, uint16_t Seq>
 		struct Pinlist<First, SequenceOf<Seq>>
 		{
+			using value_type = typename SelectSize<Seq>::type;
 			enum
 			{
 				offset = First::position,
-				mask = Private::NumberToMask<Seq>::value << offset
+				mask = (uint32_t)Private::NumberToMask<Seq>::value << offset
 			};
 			using Port = typename First::Port;
-			static uint16_t ReadODR()
+			static value_type ReadODR()
 			{
 				return (Port::ReadODR() & mask) >> offset;
 			}
-			static uint16_t Read()
+			static value_type Read()
 			{
 				return (Port::Read() & mask) >> offset;
 			}
-			static void Write(uint16_t value)
+			static void Write(value_type value)
 			{
-				value = (value << offset) & mask;
-				Port::ClearAndSet(~value & mask, value);
+				const uint32_t bits = ((uint32_t)value << offset) & mask;
+				Port::ClearAndSet(~bits & mask, bits);
 			}
 			template<OutputConf conf, OutputMode mode>
 			static void SetConfig()
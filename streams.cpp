@@ -27,15 +27,6 @@
 namespace Mcucpp {
 	namespace Io {
 
-		uint8_t* to_lower(uint8_t* str)
-		{
-			while(*str)
-			{
-				*str = std::tolower(*str);
-				str++;
-			}
-			return str;
-		}
 /*namespace Internal
 {
 		uint8_t* utoa_rev(uint32_t value, uint8_t* ptr, uint32_t base)
@@ -65,65 +56,215 @@ namespace Mcucpp {
 			return retptr;
 		}
 }*///Internal
-		uint8_t* itoa(int32_t value, uint8_t* result, uint8_t base)
+namespace {
+		const uint8_t digitPairs[201] =
+			"00010203040506070809"
+			"10111213141516171819"
+			"20212223242526272829"
+			"30313233343536373839"
+			"40414243444546474849"
+			"50515253545556575859"
+			"60616263646566676869"
+			"70717273747576777879"
+			"80818283848586878889"
+			"90919293949596979899";
+
+		//Exact for the whole uint32_t range, no division helper on cores without a divider
+		inline uint32_t Div100(uint32_t value)
 		{
-			// check that the base if valid
-//			if (base < 2 || base > 16) { *result = 0; return result; }
+			return (uint64_t)value * 0x51EB851FU >> 37;
+		}
+		inline uint32_t Div10(uint32_t value)
+		{
+			return (uint64_t)value * 0xCCCCCCCDU >> 35;
+		}
 
-			uint8_t* out = result;
-			uint32_t quotient = value < 0 ? -value : value;
-			do {
-				const uint32_t q = quotient / base;
-				const uint32_t rem = quotient - q * base;
-				quotient = q;
-				*out++ = (rem < 10 ? '0' : 'a' - 10) + rem;
-			} while ( quotient );
-		// Apply negative sign
-			if ( value < 0) *out++ = '-';
-			*out-- = '\0';
-			uint8_t tmp_char;
-			uint8_t* ptr1 = result;
-			while(ptr1 < out)
+		//value /= divisor by long division over 16-bit limbs, every step fits in 32 bits
+		//and the constant divisor turns into a multiplication
+		template<uint32_t divisor>
+		inline uint32_t DivMod(uint64_t& value)
+		{
+			static_assert(divisor <= 0x10000, "remainder must fit in 16 bits");
+			const uint32_t hi = value >> 32;
+			const uint32_t lo = (uint32_t)value;
+			uint32_t t = hi >> 16;
+			const uint32_t q3 = t / divisor;
+			t = (t - q3 * divisor) << 16 | (hi & 0xFFFF);
+			const uint32_t q2 = t / divisor;
+			t = (t - q2 * divisor) << 16 | lo >> 16;
+			const uint32_t q1 = t / divisor;
+			t = (t - q1 * divisor) << 16 | (lo & 0xFFFF);
+			const uint32_t q0 = t / divisor;
+			value = (uint64_t)(q3 << 16 | q2) << 32 | (q1 << 16 | q0);
+			return t - q0 * divisor;
+		}
+
+		const uint8_t hexPairs[513] =
+			"000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"
+			"202122232425262728292a2b2c2d2e2f"
+			"303132333435363738393a3b3c3d3e3f"
+			"404142434445464748494a4b4c4d4e4f"
+			"505152535455565758595a5b5c5d5e5f"
+			"606162636465666768696a6b6c6d6e6f"
+			"707172737475767778797a7b7c7d7e7f"
+			"808182838485868788898a8b8c8d8e8f"
+			"909192939495969798999a9b9c9d9e9f"
+			"a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+			"b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+			"c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+			"d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+			"e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+			"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+}//anonymous
+
+		uint8_t* Internal::Utoa10(uint32_t value, uint8_t* ptr)
+		{
+			while(value >= 100)
 			{
-				tmp_char = *out;
-				*out-- = *ptr1;
-				*ptr1++ = tmp_char;
+				const uint32_t q = Div100(value);
+				const uint32_t rem = value - q * 100;
+				value = q;
+				ptr -= 2;
+				ptr[0] = digitPairs[rem * 2];
+				ptr[1] = digitPairs[rem * 2 + 1];
+			}
+			if(value >= 10)
+			{
+				ptr -= 2;
+				ptr[0] = digitPairs[value * 2];
+				ptr[1] = digitPairs[value * 2 + 1];
 			}
+			else
+				*--ptr = '0' + value;
+			return ptr;
+		}
+
+		uint8_t* itoa(int32_t value, uint8_t* result, uint8_t base)
+		{
+			uint8_t buf[33];
+			uint8_t* const bufEnd = buf + sizeof(buf);
+			uint8_t* ptr = utoa(value < 0 ? 0U - (uint32_t)value : (uint32_t)value, bufEnd, base);
+			if(value < 0) *--ptr = '-';
+			const size_t length = bufEnd - ptr;
+			memcpy(result, ptr, length);
+			result[length] = '\0';
 			return result;
 		}
 
 		uint8_t* utoa(uint32_t value, uint8_t* bufferEnd, uint8_t base)
 		{
-				uint8_t* ptr = bufferEnd;
+			switch(base)
+			{
+			case 10: return Internal::Utoa10(value, bufferEnd);
+			case 16: return Internal::UtoaPow2<4>(value, bufferEnd);
+			case 8: return Internal::UtoaPow2<3>(value, bufferEnd);
+			case 2: return Internal::UtoaPow2<1>(value, bufferEnd);
+			default: break;
+			}
+			uint8_t* ptr = bufferEnd;
+			do
+			{
+				uint32_t q = value / base;
+				uint32_t rem = value - q * base;
+				value = q;
+				*--ptr = (rem < 10 ? '0' : 'a' - 10) + rem;
+			} while (value != 0);
+			return ptr;
+		}
+
+		uint8_t* Internal::Utoa10(uint32_t value, uint8_t* ptr, uint8_t point)
+		{
+			if(!point)
+				return Utoa10(value, ptr);
+			do
+			{
+				const uint32_t q = Div10(value);
+				*--ptr = '0' + (value - q * 10);
+				value = q;
+			} while(--point);
+			*--ptr = '.';
+			return Utoa10(value, ptr);
+		}
+
+		uint8_t* Internal::Utoa64(uint64_t value, uint8_t* ptr, uint8_t point)
+		{
+			if(!(value >> 32))
+				return Utoa10((uint32_t)value, ptr, point);
+			if(point)
+			{
 				do
 				{
-					uint32_t q = value / base;
-					uint32_t rem = value - q * base;
-					value = q;
-					*--ptr = (rem < 10 ? '0' : 'a' - 10) + rem;
-				} while (value != 0);
-				return ptr;
+					*--ptr = '0' + DivMod<10>(value);
+				} while(--point);
+				*--ptr = '.';
+			}
+			//4 digits per step until the rest fits the 32-bit path
+			while(value >> 32)
+			{
+				const uint32_t rem = DivMod<10000>(value);
+				const uint32_t high = Div100(rem);
+				const uint32_t low = rem - high * 100;
+				ptr -= 4;
+				ptr[0] = digitPairs[high * 2];
+				ptr[1] = digitPairs[high * 2 + 1];
+				ptr[2] = digitPairs[low * 2];
+				ptr[3] = digitPairs[low * 2 + 1];
+			}
+			return Utoa10((uint32_t)value, ptr);
 		}
 
-		uint8_t* InsertDot(uint32_t value, uint8_t position, uint8_t* buf)
+		//hexdump -C layout, each line is built whole and sent as one block
+		void Ostream::HexDump(const void* data, size_t length, uint32_t offset)
 		{
-			auto len = strlen((const char*)Io::itoa(value, buf));
-			if(len <= position)
+			enum
+			{
+				BytesPerLine = 16,
+				HexSize = BytesPerLine * 3 + 1,
+				LineSize = 8 + 2 + HexSize + 2 + BytesPerLine + 1 + 2
+			};
+			const uint8_t* src = (const uint8_t*)data;
+			uint8_t line[LineSize];
+			Flush();
+			while(length)
 			{
-				const uint8_t offset = position + 2 - len;
-				memmove(buf + offset, buf, len + 1);
-				buf[0] = '0';
-				buf[1] = '.';
-				for(uint8_t x = 2; x < offset; ++x)
+				const size_t count = length < BytesPerLine ? length : (size_t)BytesPerLine;
+				uint8_t* ptr = line + 8;
+				Internal::UtoaPow2<4, 8>(offset, ptr);
+				*ptr++ = ' ';
+				*ptr++ = ' ';
+				memset(ptr, ' ', HexSize);
+				for(size_t i = 0; i < count; ++i)
 				{
-					buf[x] = '0';
+					uint8_t* const cell = ptr + i * 3 + (i >= BytesPerLine / 2);
+					cell[0] = hexPairs[src[i] * 2];
+					cell[1] = hexPairs[src[i] * 2 + 1];
 				}
+				ptr += HexSize;
+				*ptr++ = ' ';
+				*ptr++ = '|';
+				for(size_t i = 0; i < count; ++i)
+					*ptr++ = src[i] >= 0x20 && src[i] < 0x7F ? src[i] : '.';
+				*ptr++ = '|';
+				*ptr++ = '\r';
+				*ptr++ = '\n';
+				Send(line, ptr - line);
+				src += count;
+				offset += count;
+				length -= count;
 			}
-			else	//length > position
-			{
-				memmove(buf + len - position + 1, buf + len - position, position + 1);
-				buf[len - position] = '.';
-			}
+		}
+
+		//The digits are written right to left, so the length is counted first
+		uint8_t* InsertDot(uint32_t value, uint8_t position, uint8_t* buf)
+		{
+			size_t length = 1;
+			for(uint32_t rest = value; rest >= 10; rest = Div10(rest))
+				++length;
+			if(position)
+				length = (length > position ? length : position + 1) + 1;
+			Internal::Utoa10(value, buf + length, position);
+			buf[length] = '\0';
 			return buf;
 		}
 	}//IO
@@ -26,20 +26,85 @@
 
 #include <type_traits>
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "utils.h"
+#include "stringUtils.h"
 namespace Mcucpp {
 	namespace Io {
 
-		uint8_t* to_lower(uint8_t* str);
-
 		uint8_t* utoa(uint32_t value, uint8_t* bufferEnd, uint8_t base = 10);	//ptr points to the end of buf
 		uint8_t* itoa(int32_t value, uint8_t* result, uint8_t base = 10);
 		template<typename T>
 		inline T* itoa(int32_t value, T* result, uint8_t base = 10)
 		{
 			static_assert(sizeof(T) == 1, "itoa pointer data type error");
-			return (T*)itoa(value, (char*)result, base);
+			return (T*)itoa(value, (uint8_t*)result, base);
+		}
+
+		namespace Internal {
+			uint8_t* Utoa10(uint32_t value, uint8_t* ptr);
+			//Fixed-point: the last 'point' digits go after the dot, zero-extended as needed ("0.05")
+			uint8_t* Utoa10(uint32_t value, uint8_t* ptr, uint8_t point);
+			//Without 64-bit division, see streams.cpp
+			uint8_t* Utoa64(uint64_t value, uint8_t* ptr, uint8_t point = 0);
+
+			template<uint8_t shift>
+			inline uint8_t* UtoaPow2(uint32_t value, uint8_t* ptr)
+			{
+				do
+				{
+					*--ptr = "0123456789abcdef"[value & ((1U << shift) - 1)];
+					value >>= shift;
+				} while(value);
+				return ptr;
+			}
+			//Fixed digit count, the loop is unrolled by the compiler
+			template<uint8_t shift, uint8_t digits>
+			inline uint8_t* UtoaPow2(uint32_t value, uint8_t* ptr)
+			{
+				for(uint8_t i = 0; i < digits; ++i)
+				{
+					*--ptr = "0123456789abcdef"[value & ((1U << shift) - 1)];
+					value >>= shift;
+				}
+				return ptr;
+			}
+			template<DataFormat format>
+			inline uint8_t* Utoa(uint32_t value, uint8_t* ptr, Int2Type<10>)
+			{
+				return Utoa10(value, ptr);
+			}
+			template<DataFormat format, uint32_t base>
+			inline uint8_t* Utoa(uint32_t value, uint8_t* ptr, Int2Type<base>)
+			{
+				return UtoaPow2<Mask2Position<base>::value, PrivateUtils::UtoaTraits<format>::asize - 1>(value, ptr);
+			}
+		}
+
+		//Base resolved at compile time, Bin and Hex formats are zero-padded to their full width
+		template<DataFormat format>
+		inline uint8_t* utoa(uint32_t value, uint8_t* bufferEnd)
+		{
+			return Internal::Utoa<format>(value, bufferEnd, Int2Type<PrivateUtils::UtoaTraits<format>::base>());
+		}
+		//Only Dec is signed, Bin and Hex print the two's complement bit pattern
+		template<DataFormat format, typename T>
+		inline T* itoa(int32_t value, T* result)
+		{
+			static_assert(sizeof(T) == 1, "itoa pointer data type error");
+			uint8_t buf[PrivateUtils::UtoaTraits<format>::asize];
+			uint8_t* const bufEnd = buf + sizeof(buf);
+			const bool negative = format == DataFormat::Dec && value < 0;
+			uint8_t* ptr = utoa<format>(negative ? 0U - (uint32_t)value : (uint32_t)value, bufEnd);
+			if(negative) *--ptr = '-';
+			const size_t length = bufEnd - ptr;
+			memcpy(result, ptr, length);
+			result[length] = '\0';
+			return result;
 		}
 
+		//buf takes max(digits, position + 1) + 2 bytes: dot, digits and terminator
 		uint8_t* InsertDot(uint32_t value, uint8_t position, uint8_t* buf);
 
 		enum class System
@@ -62,8 +127,20 @@ namespace Mcucpp {
 		}
 
 		using putfunc_t = void(&)(uint8_t);
+		using writefunc_t = void(&)(const uint8_t*, size_t);
 
 		class Ostream;
+		namespace Internal {
+			struct FormatEmitter;
+		}
+
+		//Value tagged with its output format, see hex8() and friends
+		template<DataFormat format>
+		struct Formatted
+		{
+			typedef typename std::conditional<format == DataFormat::Dec, int32_t, uint32_t>::type value_type;
+			value_type value;
+		};
 
 		template<typename T>
 		using pManip_t = Ostream&(*)(Ostream&, T);
@@ -77,71 +154,194 @@ namespace Mcucpp {
 		public:
 			omanip(pManip_t<T> manip, T value) : manip_(manip), value_(value)
 			{	}
-			Ostream& operator()(Ostream& os)
+			Ostream& operator()(Ostream& os) const
 			{
 				return manip_(os, value_);
 			}
 
 		};
 
+		//Output is formatted into a small staging buffer and handed to the sink in blocks,
+		//each insertion is flushed as a whole
 		class Ostream
 		{
 		private:
+			friend struct Internal::FormatEmitter;
 			using Self = Ostream;
+			enum { StageSize = 32 };
+		public:
+			enum { MaxPoint = 10 };
+		private:
 
-			putfunc_t Put_;
+			void (*const Put_)(uint8_t);
+			void (*const Write_)(const uint8_t*, size_t);
 			System numsystem_ = System::dec;
 			Adjust adj_ = left;
 			uint8_t tabw_ = 4;
 			uint8_t fieldw_ = 16;
 			uint8_t pointpos_ = 0;
+			uint8_t staged_ = 0;
+			uint8_t stage_[StageSize];
+
+			void Send(const uint8_t* data, size_t length)
+			{
+				if(Write_)
+					Write_(data, length);
+				else	//per-char sink
+					while(length--)
+						Put_(*data++);
+			}
 			void Putc(uint8_t ch)
 			{
-				Put_(ch);
+				if(staged_ == StageSize)
+					Flush();
+				stage_[staged_++] = ch;
+			}
+			void Puts(const uint8_t* str, size_t length)
+			{
+				if(staged_ + length > StageSize)
+				{
+					Flush();
+					if(length >= StageSize)
+					{
+						Send(str, length);
+						return;
+					}
+				}
+				memcpy(stage_ + staged_, str, length);
+				staged_ += length;
 			}
 			void Puts(const uint8_t* str)
 			{
-				while(*str)
-					Put_(*str++);
+				Puts(str, strlen((const char*)str));
 			}
 			void Puts(const char* str)
 			{
 				Puts((const uint8_t*)str);
 			}
-
-			void Put(int32_t value)
+			void Pad(uint16_t n, uint8_t sym)
 			{
-				constexpr uint8_t maxPrefixSize = 3;
-				uint8_t prefix[maxPrefixSize];
-				uint8_t* prefixPtr = prefix + maxPrefixSize;
-				*--prefixPtr = '\0';
-				if(numsystem_ == System::dec)
+				while(n)
 				{
-					if(value < 0)
-					{
-						value = -value;
-						*--prefixPtr = '-';
-					}
+					if(staged_ == StageSize)
+						Flush();
+					const uint16_t chunk = n < StageSize - staged_ ? n : StageSize - staged_;
+					memset(stage_ + staged_, sym, chunk);
+					staged_ += chunk;
+					n -= chunk;
 				}
-				else //hex
+			}
+
+			//Zero fill goes between the prefix and the digits
+			void PutField(const char* prefix, uint8_t prefixLength, const uint8_t* str, uint8_t length,
+						uint8_t width, Adjust adj, uint8_t fill)
+			{
+				const uint32_t outputLength = prefixLength + length;
+				const uint16_t padding = outputLength < width ? width - outputLength : 0;
+				if(fill != ' ')
 				{
-					*--prefixPtr = 'x';
-					*--prefixPtr = '0';
+					Puts((const uint8_t*)prefix, prefixLength);
+					Pad(padding, fill);
+					Puts(str, length);
+					return;
 				}
-				constexpr uint8_t bufSize = 11;
-				uint8_t buf[bufSize];
-				uint8_t* str = utoa(value, buf + bufSize, static_cast<uint8_t>(numsystem_));
-				uint32_t outputLength = buf + bufSize - str + prefix + maxPrefixSize - prefixPtr - 1;
-				if(adj_ == right) Fill(fieldw_ - outputLength);
-				if(adj_ == center) Fill((fieldw_ - outputLength) >> 1);
-				Puts(prefixPtr);
-				Puts(str);
-				if(adj_ == center) Fill((fieldw_ - outputLength) >> 1);
-				if(adj_ == left) Fill(fieldw_ - outputLength);
+				if(adj == right) Pad(padding, ' ');
+				if(adj == center) Pad(padding >> 1, ' ');
+				Puts((const uint8_t*)prefix, prefixLength);
+				Puts(str, length);
+				if(adj == center) Pad(padding >> 1, ' ');
+				if(adj == left) Pad(padding, ' ');
+			}
+			void PutField(const char* prefix, uint8_t prefixLength, const uint8_t* str, uint8_t length)
+			{
+				PutField(prefix, prefixLength, str, length, fieldw_, adj_, ' ');
+			}
+			template<DataFormat format>
+			void PutFormatted(int32_t value, Int2Type<10>)
+			{
+				uint8_t buf[PrivateUtils::UtoaTraits<format>::asize];
+				uint8_t* const bufEnd = buf + sizeof(buf);
+				const uint8_t* str = utoa<format>(value < 0 ? 0U - (uint32_t)value : (uint32_t)value, bufEnd);
+				PutField("-", value < 0, str, bufEnd - str);
+			}
+			template<DataFormat format, uint32_t base>
+			void PutFormatted(uint32_t value, Int2Type<base>)
+			{
+				uint8_t buf[PrivateUtils::UtoaTraits<format>::asize];
+				uint8_t* const bufEnd = buf + sizeof(buf);
+				const uint8_t* str = utoa<format>(value, bufEnd);
+				PutField(base == 16 ? "0x" : "0b", 2, str, bufEnd - str);
+			}
+
+			void PutDec(uint32_t value, bool negative)
+			{
+				uint8_t buf[MaxPoint + 2];
+				uint8_t* const bufEnd = buf + sizeof(buf);
+				const uint8_t* str = Internal::Utoa10(value, bufEnd, pointpos_);
+				PutField("-", negative, str, bufEnd - str);
+			}
+			void PutDec(uint64_t value, bool negative)
+			{
+				uint8_t buf[20 + 1];
+				uint8_t* const bufEnd = buf + sizeof(buf);
+				const uint8_t* str = Internal::Utoa64(value, bufEnd, pointpos_);
+				PutField("-", negative, str, bufEnd - str);
+			}
+			void PutHex(uint32_t value)
+			{
+				uint8_t buf[8];
+				uint8_t* const bufEnd = buf + sizeof(buf);
+				const uint8_t* str = Internal::UtoaPow2<4>(value, bufEnd);
+				PutField("0x", 2, str, bufEnd - str);
+			}
+			void PutHex(uint64_t value)
+			{
+				uint8_t buf[16];
+				uint8_t* const bufEnd = buf + sizeof(buf);
+				uint8_t* str;
+				if(value >> 32)
+					str = Internal::UtoaPow2<4>(value >> 32, Internal::UtoaPow2<4, 8>(value, bufEnd));
+				else
+					str = Internal::UtoaPow2<4>(value, bufEnd);
+				PutField("0x", 2, str, bufEnd - str);
+			}
+
+			template<typename T>
+			static bool IsNegative(T value, Int2Type<true>)
+			{
+				return value < 0;
+			}
+			template<typename T>
+			static bool IsNegative(T, Int2Type<false>)
+			{
+				return false;
+			}
+			//Dispatch on the argument type, overloads would be ambiguous where int32_t is long.
+			//Non-integral arguments keep the old conversion to int32_t
+			template<typename T>
+			void Put(T value)
+			{
+				typedef typename std::conditional<std::is_integral<T>::value, T, int32_t>::type Integer;
+				typedef typename std::conditional<(sizeof(Integer) > 4), uint64_t, uint32_t>::type Unsigned;
+				const Integer integer = static_cast<Integer>(value);
+				const Unsigned bits = static_cast<Unsigned>(integer);
+				const bool negative = IsNegative(integer, Int2Type<std::is_signed<Integer>::value>());
+				if(numsystem_ == System::dec)
+					PutDec(negative ? Unsigned(0) - bits : bits, negative);
+				else //hex, two's complement for negative values
+					PutHex(bits);
+			}
+			template<DataFormat format>
+			void Put(Formatted<format> f)
+			{
+				PutFormatted<format>(f.value, Int2Type<PrivateUtils::UtoaTraits<format>::base>());
 			}
 
 		public:
-			Ostream(putfunc_t Put) : Put_(Put)
+			//Per-char sink, kept for existing drivers
+			Ostream(putfunc_t Put) : Put_(&Put), Write_(nullptr)
+			{	}
+			Ostream(writefunc_t Write) : Put_(nullptr), Write_(&Write)
 			{	}
 			Self& operator<<(Self&(*pf)(Self&))
 			{
@@ -156,34 +356,44 @@ namespace Mcucpp {
 			Self& operator<<(T obj)
 			{
 				Put(obj);
+				Flush();
 				return *this;
 			}
 			template<typename T>
 			Self& operator<<(T* obj)
 			{
 				Puts(obj);
+				Flush();
 				return *this;
 			}
+			//Offset, hex and ASCII columns, 16 bytes per line
+			void HexDump(const void* data, size_t length, uint32_t offset = 0);
+			void Flush()
+			{
+				if(staged_)
+				{
+					Send(stage_, staged_);
+					staged_ = 0;
+				}
+			}
 			void Fill(uint16_t n, uint8_t sym = ' ')
 			{
-				while(n--)
-					Put_(sym);
+				Pad(n, sym);
+				Flush();
 			}
 			void endl()
 			{
-				Puts("\r\n");
+				Puts((const uint8_t*)"\r\n", 2);
+				Flush();
 			}
 			void ends()
 			{
-				Put_('\0');
+				Putc('\0');
+				Flush();
 			}
 			void tab()
 			{
-				uint8_t n = tabw_;
-				while(n--)
-				{
-					Put_(' ');
-				}
+				Fill(tabw_);
 			}
 			void SetTabWidth(uint8_t w)
 			{
@@ -193,6 +403,11 @@ namespace Mcucpp {
 			{
 				fieldw_ = w;
 			}
+			//Decimal values are printed as fixed-point with n fractional digits, 0 turns it off
+			void SetPoint(uint8_t n)
+			{
+				pointpos_ = n < MaxPoint ? n : (uint8_t)MaxPoint;
+			}
 			void SetSystem(System ns)
 			{
 				numsystem_ = ns;
@@ -213,6 +428,11 @@ namespace Mcucpp {
 			os.ends();
 			return os;
 		}
+		inline Ostream& flush(Ostream& os)
+		{
+			os.Flush();
+			return os;
+		}
 		inline Ostream& hex(Ostream& os)
 		{
 			os.SetSystem(System::hex);
@@ -233,6 +453,30 @@ namespace Mcucpp {
 		{
 			return omanip<uint8_t>(setw, w);
 		}
+		inline Ostream& setpoint(Ostream& os, uint8_t n)
+		{
+			os.SetPoint(n);
+			return os;
+		}
+		inline omanip<uint8_t> setpoint(uint8_t n)
+		{
+			return omanip<uint8_t>(setpoint, n);
+		}
+		struct HexDumpSpan
+		{
+			const void* data;
+			size_t length;
+			uint32_t offset;
+		};
+		inline Ostream& hexdump(Ostream& os, HexDumpSpan span)
+		{
+			os.HexDump(span.data, span.length, span.offset);
+			return os;
+		}
+		inline omanip<HexDumpSpan> hexdump(const void* data, size_t length, uint32_t offset = 0)
+		{
+			return omanip<HexDumpSpan>(hexdump, HexDumpSpan{ data, length, offset });
+		}
 		inline Ostream& setTabw(Ostream& os, uint8_t w)
 		{
 			os.SetTabWidth(w);
@@ -243,8 +487,339 @@ namespace Mcucpp {
 			return omanip<uint8_t>(setTabw, w);
 		}
 
-		namespace Internal {
-			uint8_t* utoa(uint32_t value, uint8_t* ptr, uint32_t base = 10);
+		//Base fixed per call site, not switched on per value
+		template<DataFormat format, typename T>
+		inline Formatted<format> fmt(T value)
+		{
+			return Formatted<format>{ static_cast<typename Formatted<format>::value_type>(value) };
+		}
+		inline Formatted<DataFormat::Hex8> hex8(uint8_t value)
+		{
+			return fmt<DataFormat::Hex8>(value);
+		}
+		inline Formatted<DataFormat::Hex16> hex16(uint16_t value)
+		{
+			return fmt<DataFormat::Hex16>(value);
+		}
+		inline Formatted<DataFormat::Hex32> hex32(uint32_t value)
+		{
+			return fmt<DataFormat::Hex32>(value);
+		}
+		inline Formatted<DataFormat::Bin8> bin8(uint8_t value)
+		{
+			return fmt<DataFormat::Bin8>(value);
+		}
+		inline Formatted<DataFormat::Bin16> bin16(uint16_t value)
+		{
+			return fmt<DataFormat::Bin16>(value);
+		}
+		inline Formatted<DataFormat::Bin32> bin32(uint32_t value)
+		{
+			return fmt<DataFormat::Bin32>(value);
+		}
+
+		using readfunc_t = size_t(&)(uint8_t*, size_t);
+
+		//Block read function behind the Peek()/Consume() interface of CircularBuffer
+		template<size_t BufSize = 32>
+		class BlockSource
+		{
+		private:
+			size_t (*const Read_)(uint8_t*, size_t);
+			size_t begin_ = 0;
+			size_t end_ = 0;
+			uint8_t buf_[BufSize];
+		public:
+			BlockSource(readfunc_t Read) : Read_(&Read)
+			{	}
+			const uint8_t* Peek(size_t& length)
+			{
+				if(begin_ == end_)
+				{
+					begin_ = 0;
+					end_ = Read_(buf_, BufSize);
+				}
+				length = end_ - begin_;
+				return buf_ + begin_;
+			}
+			void Consume(size_t length)
+			{
+				begin_ += length;
+			}
+		};
+
+		//Whitespace delimited word, truncated to size - 1 chars and NUL terminated, size 0 skips it
+		struct TokenSpan
+		{
+			uint8_t* data;
+			size_t size;
+		};
+		template<typename T>
+		inline TokenSpan token(T* buf, size_t size)
+		{
+			static_assert(sizeof(T) == 1, "token pointer data type error");
+			return TokenSpan{ (uint8_t*)buf, size };
+		}
+
+		//Parses from any source with CircularBuffer's Peek()/Consume() interface, a whole
+		//contiguous region at a time. A value that runs into the end of the available data
+		//returns pending and keeps its partial state, repeat the same Get() when more data arrives.
+		//A number or token ends at the first char that doesn't belong to it, that char is left unread.
+		template<typename Source>
+		class Istream
+		{
+		public:
+			enum Status
+			{
+				ok, pending, error
+			};
+		private:
+			using Self = Istream;
+			enum Stage : uint8_t
+			{
+				idle, sign, integer, fraction, word
+			};
+
+			Source& src_;
+			Status status_ = ok;
+			uint8_t base_ = 10;
+			uint8_t pointpos_ = 0;
+			//Partial value
+			Stage stage_ = idle;
+			bool negative_ = false;
+			bool digits_ = false;
+			bool overflow_ = false;
+			uint8_t fraction_ = 0;
+			size_t tokenLength_ = 0;
+			uint64_t acc_ = 0;
+
+			static bool IsSpace(uint8_t ch)
+			{
+				return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+			}
+			//Digits and letters of bases up to 36, 0xFF for anything else
+			static uint8_t Digit(uint8_t ch)
+			{
+				uint8_t d = ch - '0';
+				if(d < 10)
+					return d;
+				d = (ch | 0x20) - 'a';
+				return d < 26 ? d + 10 : 0xFF;
+			}
+			const uint8_t* Peek(size_t& length)
+			{
+				return (const uint8_t*)src_.Peek(length);
+			}
+			void Reset()
+			{
+				stage_ = idle;
+				negative_ = false;
+				digits_ = false;
+				overflow_ = false;
+				fraction_ = 0;
+				tokenLength_ = 0;
+				acc_ = 0;
+			}
+
+			template<typename Acc>
+			void Accumulate(Acc& acc, uint8_t d, uint8_t base, Acc cutoff, uint8_t cutlim)
+			{
+				digits_ = true;
+				if(acc > cutoff || (acc == cutoff && d > cutlim))
+					overflow_ = true;
+				else
+					acc = acc * base + d;
+			}
+			template<typename Acc>
+			Status Finish(Acc acc, Acc cutoff, uint8_t cutlim)
+			{
+				const bool digits = digits_;
+				for(; fraction_ < pointpos_; ++fraction_)
+					Accumulate<Acc>(acc, 0, 10, cutoff, cutlim);
+				acc_ = acc;
+				return digits && !overflow_ ? ok : error;
+			}
+			//Magnitude up to limit is left in acc_, fixed-point values are decimal
+			template<typename Acc>
+			Status ScanNumber(Acc limit)
+			{
+				const uint8_t base = pointpos_ ? 10 : base_;
+				const Acc cutoff = limit / base;
+				const uint8_t cutlim = limit - cutoff * base;
+				Acc acc = (Acc)acc_;
+				size_t length;
+				const uint8_t* data;
+				while(data = Peek(length), length)
+				{
+					size_t i = 0;
+					if(stage_ == idle)
+					{
+						while(i < length && IsSpace(data[i]))
+							++i;
+						if(i < length)
+							stage_ = sign;
+					}
+					if(stage_ == sign && i < length)
+					{
+						if(data[i] == '-' || data[i] == '+')
+							negative_ = data[i++] == '-';
+						stage_ = integer;
+					}
+					if(stage_ == integer)
+					{
+						for(; i < length; ++i)
+						{
+							const uint8_t d = Digit(data[i]);
+							if(d >= base)
+								break;
+							Accumulate(acc, d, base, cutoff, cutlim);
+						}
+						if(i < length)
+						{
+							if(data[i] != '.' || !pointpos_)
+							{
+								src_.Consume(i);
+								return Finish(acc, cutoff, cutlim);
+							}
+							stage_ = fraction;
+							++i;
+						}
+					}
+					if(stage_ == fraction)
+					{
+						for(; i < length; ++i)
+						{
+							const uint8_t d = Digit(data[i]);
+							if(d >= 10)
+								break;
+							if(fraction_ < pointpos_)	//excess fractional digits are dropped
+							{
+								Accumulate(acc, d, 10, cutoff, cutlim);
+								++fraction_;
+							}
+						}
+						if(i < length)
+						{
+							src_.Consume(i);
+							return Finish(acc, cutoff, cutlim);
+						}
+					}
+					src_.Consume(i);
+				}
+				acc_ = acc;
+				return pending;
+			}
+
+		public:
+			Istream(Source& src) : src_(src)
+			{	}
+
+			template<typename T>
+			Status Get(T& value)
+			{
+				static_assert(std::is_integral<T>::value && !std::is_same<T, bool>::value, "Istream: integer type expected");
+				typedef typename std::make_unsigned<T>::type Unsigned;
+				typedef typename std::conditional<(sizeof(T) > 4), uint64_t, uint32_t>::type Acc;
+				const Acc max = std::is_signed<T>::value ? (Unsigned)~Unsigned(0) >> 1 : (Unsigned)~Unsigned(0);
+				Status status = ScanNumber<Acc>(max + std::is_signed<T>::value);
+				if(status == pending)
+					return pending;
+				if(status == ok)
+				{
+					if(negative_ ? !std::is_signed<T>::value : acc_ > max)
+						status = error;
+					else
+						value = negative_ ? (T)(Unsigned)(0 - (Unsigned)acc_) : (T)acc_;
+				}
+				Reset();
+				return status;
+			}
+			Status Get(TokenSpan token)
+			{
+				size_t length;
+				const uint8_t* data;
+				while(data = Peek(length), length)
+				{
+					size_t i = 0;
+					if(stage_ == idle)
+					{
+						while(i < length && IsSpace(data[i]))
+							++i;
+						if(i < length)
+							stage_ = word;
+					}
+					const size_t start = i;
+					while(i < length && !IsSpace(data[i]))
+						++i;
+					const size_t room = token.size ? token.size - 1 - tokenLength_ : 0;
+					const size_t copy = i - start < room ? i - start : room;
+					memcpy(token.data + tokenLength_, data + start, copy);
+					tokenLength_ += copy;
+					src_.Consume(i);
+					if(i < length)
+					{
+						if(token.size)
+							token.data[tokenLength_] = '\0';
+						Reset();
+						return ok;
+					}
+				}
+				return pending;
+			}
+
+			//Extractions after a failed or pending one are skipped until Clear()
+			template<typename T>
+			Self& operator>>(T& value)
+			{
+				if(status_ == ok)
+					status_ = Get(value);
+				return *this;
+			}
+			Self& operator>>(TokenSpan token)
+			{
+				if(status_ == ok)
+					status_ = Get(token);
+				return *this;
+			}
+			Self& operator>>(Self&(*pf)(Self&))
+			{
+				return pf(*this);
+			}
+			explicit operator bool() const
+			{
+				return status_ == ok;
+			}
+			Status State() const
+			{
+				return status_;
+			}
+			//The partial value of a pending extraction is kept
+			void Clear()
+			{
+				status_ = ok;
+			}
+			void SetBase(uint8_t base)
+			{
+				base_ = base < 2 ? 2 : base > 36 ? 36 : base;
+			}
+			//Fixed-point: "12.5" is read as 1250 with n = 2
+			void SetPoint(uint8_t n)
+			{
+				pointpos_ = n;
+			}
+		};
+
+		template<typename Source>
+		inline Istream<Source>& hex(Istream<Source>& is)
+		{
+			is.SetBase(16);
+			return is;
+		}
+		template<typename Source>
+		inline Istream<Source>& dec(Istream<Source>& is)
+		{
+			is.SetBase(10);
+			return is;
 		}
 
 	}//IO
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "stringUtils.h"
+#include <string.h>
+#if defined(__SSE2__) && !defined(MCUCPP_NO_SIMD)
+#include <emmintrin.h>
+#define STRINGUTILS_SSE2
+#endif
+
+//Word and vector loops start at an aligned address and read a whole block even past the
+//terminator. Such a block never crosses into the next page, so this can't fault, but the
+//bytes past the end are still out of bounds for C++ and ASan. The kernels are built
+//without ASan checks and load through a may_alias word the compiler makes no assumptions on.
+#ifdef __GNUC__
+#define STRINGUTILS_OVERREAD __attribute__((no_sanitize_address))
+#else
+#define STRINGUTILS_OVERREAD
+#endif
+
+namespace Mcucpp {
+	namespace Io {
+namespace {
+		typedef size_t Word;
+#ifdef __GNUC__
+		typedef Word __attribute__((may_alias)) AliasWord;
+#endif
+		const Word ones = (Word)~(Word)0 / 0xFF;
+		const Word highs = ones * 0x80;
+#ifdef STRINGUTILS_SSE2
+		const size_t align = 16;
+#else
+		const size_t align = sizeof(Word);
+#endif
+
+		inline bool IsAligned(const uint8_t* ptr, size_t size)
+		{
+			return !((uintptr_t)ptr & (size - 1));
+		}
+		STRINGUTILS_OVERREAD inline Word Load(const uint8_t* ptr)
+		{
+#ifdef __GNUC__
+			return *(const AliasWord*)ptr;
+#else
+			Word w;
+			memcpy(&w, ptr, sizeof(w));
+			return w;
+#endif
+		}
+		inline bool HasZero(Word w)
+		{
+			return (w - ones) & ~w & highs;
+		}
+		//0x80 in every byte within [first, last]
+		inline Word InRange(Word w, uint8_t first, uint8_t last)
+		{
+			const Word low7 = w & ~highs;
+			const Word geFirst = low7 + ones * (0x80 - first);
+			const Word gtLast = low7 + ones * (0x7F - last);
+			return geFirst & ~gtLast & ~w & highs;
+		}
+		inline uint8_t FlipCase(uint8_t ch, uint8_t first, uint8_t last)
+		{
+			return (uint8_t)(ch - first) <= last - first ? ch ^ 0x20 : ch;
+		}
+		inline uint8_t Lower(uint8_t ch)
+		{
+			return FlipCase(ch, 'A', 'Z');
+		}
+		inline Word Lower(Word w)
+		{
+			return w | InRange(w, 'A', 'Z') >> 2;
+		}
+
+		//Toggles bit 5 of the chars in [first, last]
+		template<uint8_t first, uint8_t last>
+		STRINGUTILS_OVERREAD uint8_t* FlipCase(uint8_t* str)
+		{
+			uint8_t* ptr = str;
+			for(; !IsAligned(ptr, align); ++ptr)
+			{
+				if(!*ptr)
+					return str;
+				*ptr = FlipCase(*ptr, first, last);
+			}
+#ifdef STRINGUTILS_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i below = _mm_set1_epi8(first - 1);
+			const __m128i above = _mm_set1_epi8(last + 1);
+			const __m128i bit = _mm_set1_epi8(0x20);
+			for(;; ptr += 16)
+			{
+				__m128i v = _mm_load_si128((const __m128i*)ptr);
+				if(_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)))
+					break;
+				//signed compare, bytes above 0x7F are out of range
+				const __m128i mask = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+				v = _mm_xor_si128(v, _mm_and_si128(mask, bit));
+				_mm_store_si128((__m128i*)ptr, v);
+			}
+#endif
+			for(;; ptr += sizeof(Word))
+			{
+				Word w = Load(ptr);
+				if(HasZero(w))
+					break;
+				w ^= InRange(w, first, last) >> 2;
+				memcpy(ptr, &w, sizeof(w));
+			}
+			for(; *ptr; ++ptr)
+				*ptr = FlipCase(*ptr, first, last);
+			return str;
+		}
+}//anonymous
+
+		uint8_t* to_lower(uint8_t* str)
+		{
+			return FlipCase<'A', 'Z'>(str);
+		}
+
+		uint8_t* to_upper(uint8_t* str)
+		{
+			return FlipCase<'a', 'z'>(str);
+		}
+
+		STRINGUTILS_OVERREAD size_t str_length(const uint8_t* str)
+		{
+			const uint8_t* ptr = str;
+			for(; !IsAligned(ptr, align); ++ptr)
+			{
+				if(!*ptr)
+					return ptr - str;
+			}
+#ifdef STRINGUTILS_SSE2
+			const __m128i zero = _mm_setzero_si128();
+			for(;; ptr += 16)
+			{
+				const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128((const __m128i*)ptr), zero));
+				if(mask)
+					return ptr - str + __builtin_ctz(mask);
+			}
+#else
+			for(;; ptr += sizeof(Word))
+			{
+				if(HasZero(Load(ptr)))
+					break;
+			}
+			while(*ptr)
+				++ptr;
+			return ptr - str;
+#endif
+		}
+
+		STRINGUTILS_OVERREAD int str_casecmp(const uint8_t* str1, const uint8_t* str2)
+		{
+			//Word compare only when both strings share the alignment, otherwise the
+			//read from str2 could run into the next page
+			if(((uintptr_t)str1 ^ (uintptr_t)str2) % sizeof(Word) == 0)
+			{
+				for(; !IsAligned(str1, sizeof(Word)); ++str1, ++str2)
+				{
+					const uint8_t ch1 = Lower(*str1);
+					const uint8_t ch2 = Lower(*str2);
+					if(ch1 != ch2 || !ch1)
+						return ch1 - ch2;
+				}
+				for(;; str1 += sizeof(Word), str2 += sizeof(Word))
+				{
+					const Word w1 = Load(str1);
+					const Word w2 = Load(str2);
+					//equal lowercase words without a zero in w1 have none in w2 either
+					if(HasZero(w1) || Lower(w1) != Lower(w2))
+						break;
+				}
+			}
+			for(;; ++str1, ++str2)
+			{
+				const uint8_t ch1 = Lower(*str1);
+				const uint8_t ch2 = Lower(*str2);
+				if(ch1 != ch2 || !ch1)
+					return ch1 - ch2;
+			}
+		}
+
+	}//IO
+}//Mcucpp
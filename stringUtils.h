@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef STRINGUTILS_H
+#define STRINGUTILS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+//ASCII only string kernels, a machine word (16 bytes with SSE2) per step.
+//Bytes above 0x7F are left as they are and compare by value.
+namespace Mcucpp {
+	namespace Io {
+
+		//In place, return str
+		uint8_t* to_lower(uint8_t* str);
+		uint8_t* to_upper(uint8_t* str);
+		size_t str_length(const uint8_t* str);
+		//<0, 0, >0 like strcmp, on lowercased chars
+		int str_casecmp(const uint8_t* str1, const uint8_t* str2);
+
+	}//IO
+}//Mcucpp
+
+#endif // STRINGUTILS_H
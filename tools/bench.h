@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Timing helpers shared by the host benchmarks in tools/, see bench.py
+
+#pragma once
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <cstdio>
+
+namespace Bench {
+
+	inline double Now()
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	//Makes the compiler assume the value is used, so the measured work is not optimized away
+	template<typename T>
+	inline void Keep(const T& value)
+	{
+		asm volatile("" : : "r"(&value) : "memory");
+	}
+
+	//Best of several runs, in seconds, to cut scheduler noise
+	template<typename F>
+	double Best(F f, int runs = 5)
+	{
+		double best = 1e30;
+		for(int i = 0; i < runs; ++i)
+		{
+			const double start = Now();
+			f();
+			const double time = Now() - start;
+			if(time < best)
+				best = time;
+		}
+		return best;
+	}
+
+}//Bench
+
+#endif // BENCH_H
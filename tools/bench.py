@@ -0,0 +1,62 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Dmytro Shestakov
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""Builds and runs the host benchmarks in tools/ with optimization, prints their reports.
+
+usage: bench.py [name ...]    (all of them by default, CXX selects the compiler)
+
+A benchmark is tools/<name>_bench.cpp plus the repo sources it links, its extra
+flags and the language standard it needs. The figures are
+host figures: they compare code paths with each other, not with a target MCU.
+"""
+
+import sys
+
+import hosttest
+
+BENCHMARKS = {
+    'circularBuffer': ([], [], 'c++11'),
+    'spsc': ([], ['-pthread'], 'c++11'),
+    'mpmcQueue': ([], ['-pthread'], 'c++11'),
+    'streams': (['streams.cpp', 'utils.cpp', 'stringUtils.cpp'], [], 'c++11'),
+    'txChannel': (['streams.cpp', 'utils.cpp', 'stringUtils.cpp'], [], 'c++11'),
+    'utoa': (['streams.cpp', 'utils.cpp', 'stringUtils.cpp'], [], 'c++17'),
+}
+FLAGS = ['-O2', '-DNDEBUG']
+
+
+def main():
+    names = sys.argv[1:] or sorted(BENCHMARKS)
+    for name in names:
+        if name not in BENCHMARKS:
+            sys.exit('unknown benchmark %s, one of: %s' % (name, ' '.join(sorted(BENCHMARKS))))
+    for name in names:
+        print('%s:' % name)
+        sources, flags, std = BENCHMARKS[name]
+        status, output = hosttest.run(['tools/%s_bench.cpp' % name] + sources, FLAGS + flags, std=std)
+        print(output, end='')
+        if status:
+            sys.exit('%s failed with status %d' % (name, status))
+
+
+if __name__ == '__main__':
+    main()
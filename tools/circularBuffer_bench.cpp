@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Bulk Write/Read against the per-element loop, single thread, see bench.py
+
+#include "../circularBuffer.h"
+#include "bench.h"
+
+enum { Bytes = 64 << 20 };
+
+static CircularBuffer<1024, uint8_t> buffer;
+static uint8_t frame[256], out[256];
+
+template<size_t length>
+void PerElement()
+{
+	for(size_t done = 0; done < Bytes; done += length)
+	{
+		for(size_t i = 0; i < length; ++i)
+			buffer.Write(frame[i]);
+		for(size_t i = 0; i < length; ++i)
+			buffer.Read(out[i]);
+		Bench::Keep(out);
+	}
+}
+
+template<size_t length>
+void Bulk()
+{
+	for(size_t done = 0; done < Bytes; done += length)
+	{
+		buffer.Write(frame, length);
+		buffer.Read(out, length);
+		Bench::Keep(out);
+	}
+}
+
+template<size_t length>
+void Compare()
+{
+	const double perElement = Bench::Best(PerElement<length>);
+	const double bulk = Bench::Best(Bulk<length>);
+	printf("%4u byte frames: per element %7.1f MB/s, bulk %7.1f MB/s, x%.1f\n", (unsigned)length,
+			Bytes / perElement / 1e6, Bytes / bulk / 1e6, perElement / bulk);
+}
+
+int main()
+{
+	for(size_t i = 0; i < sizeof(frame); ++i)
+		frame[i] = (uint8_t)i;
+	Compare<1>();
+	Compare<4>();
+	Compare<16>();
+	Compare<64>();
+	Compare<256>();
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Host checks for circularBuffer.h, run by test_circularBuffer.py under ASan and UBSan
+
+#include "../circularBuffer.h"
+#include <cstdio>
+#include <string>
+
+static int failures;
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); ++failures; } } while(0)
+
+//The ISR pattern: the data register goes straight into the buffer
+template<typename T>
+void VolatileRegisterWrite()
+{
+	volatile T reg = (T)0xA5C3B4E1u;
+	static CircularBuffer<8, T> rx;	//trivial element types start from zeroed static storage
+	CHECK(rx.Write(reg));
+	T value = 0;
+	CHECK(rx.Read(value) && value == (T)0xA5C3B4E1u);
+}
+
+//Copies own their elements, destroying one must leave the other intact
+void DeepCopy()
+{
+	CircularBuffer<5, std::string> a;
+	for(int i = 0; i < 12; ++i)
+	{
+		std::string s;
+		if(a.Count() == 5)
+			a.Read(s);
+		a.Write(std::string(40, 'a' + i));
+	}
+	{
+		CircularBuffer<5, std::string> b(a);
+		CircularBuffer<5, std::string> c;
+		c.Write("x");
+		c = b;
+		std::string s, t;
+		while(c.Read(s))
+		{
+			CHECK(b.Read(t) && s == t);
+		}
+	}
+	std::string s;
+	for(int i = 7; i < 12; ++i)
+	{
+		CHECK(a.Read(s) && s == std::string(40, 'a' + i));
+	}
+	CHECK(a.IsEmpty());
+}
+
+//The high-water mark follows the consumer even when the producer's cached index does not
+template<class Sync>
+void HighWater()
+{
+	static CircularBuffer<16, uint8_t, Sync, Mcucpp::Ring::DiscardNew, Mcucpp::Ring::TrackStats> buf;
+	buf.Clear();
+	uint8_t value;
+	for(int i = 0; i < 100; ++i)
+	{
+		buf.Write(i);
+		buf.Read(value);
+	}
+	CHECK(buf.HighWater() == 1);
+	const uint8_t block[5] = { };
+	buf.Write(block, 5);
+	size_t length;
+	buf.Reserve(length);
+	buf.Commit(2);
+	CHECK(buf.HighWater() == 7);
+	CHECK(buf.Throughput() == 107);
+}
+
+//Find against a scan through operator[], at every read position and fill level
+template<typename T>
+void FindByte()
+{
+	static CircularBuffer<64, T> buf;
+	const T delim = (T)'\n';
+	uint32_t seed = 1;
+	for(int start = 0; start < 64; ++start)
+	{
+		for(size_t count = 0; count <= 64; ++count)
+		{
+			for(int trial = 0; trial < 20; ++trial)
+			{
+				buf.Clear();
+				T value = T();
+				for(int i = 0; i < start; ++i)
+				{
+					buf.Write(value);
+					buf.Read(value);
+				}
+				size_t expected = count;
+				for(size_t i = 0; i < count; ++i)
+				{
+					seed ^= seed << 13;
+					seed ^= seed >> 17;
+					seed ^= seed << 5;
+					//Other bytes differ from delim in one bit, a typical false alarm for word tests
+					value = seed % 16 ? (T)(delim ^ (1 << (seed >> 8) % 8)) : delim;
+					if(value == delim && expected == count)
+						expected = i;
+					buf.Write(value);
+				}
+				size_t position = 0;
+				CHECK(buf.Find(delim, position) == (expected < count));
+				CHECK(expected == count || position == expected);
+			}
+		}
+	}
+}
+
+int main()
+{
+	VolatileRegisterWrite<uint8_t>();
+	VolatileRegisterWrite<uint16_t>();
+	VolatileRegisterWrite<uint32_t>();
+	DeepCopy();
+	FindByte<uint8_t>();
+	FindByte<char>();
+	HighWater<Mcucpp::Ring::VolatileIndex>();
+	HighWater<Mcucpp::Ring::AtomicIndex<> >();
+	return failures != 0;
+}
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Dmytro Shestakov
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""Helpers shared by the host tests in tools/: build a test program from repo sources
+with the host compiler and run it. CXX selects the compiler, c++ by default.
+
+A test program prints a line per failed check and exits with a non-zero status.
+"""
+
+import os
+import subprocess
+import tempfile
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(TOOLS)
+
+
+def build(exe, sources, flags=(), std='c++11'):
+    subprocess.check_call([os.environ.get('CXX', 'c++'), '-std=' + std, '-Wall', '-Wextra']
+                          + list(flags) + ['-o', exe]
+                          + [os.path.join(ROOT, src) for src in sources])
+
+
+def run(sources, flags=(), args=(), std='c++11'):
+    """Builds sources into a temporary program, returns its exit status and output"""
+    with tempfile.TemporaryDirectory() as tmp:
+        exe = os.path.join(tmp, 'test')
+        build(exe, sources, flags, std)
+        result = subprocess.run([exe] + list(args), stdout=subprocess.PIPE, stderr=subprocess.STDOUT)
+        return result.returncode, result.stdout.decode('latin-1')
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Dmytro Shestakov
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""Decode Io::DeferredLog records (deferredLog.h) back into text.
+
+usage: logdecode.py firmware.elf [capture.bin]
+
+Format strings are read from the .mcucpp_log section of the ELF, records from
+the capture file or stdin: a little-endian 32-bit format string ID followed by
+the arguments, 4 bytes for d/u/x/b and 1 byte for c. The ID is the FNV-1a hash
+of the string, the same as Io::Internal::LogId.
+"""
+
+import re
+import struct
+import sys
+
+SECTION = '.mcucpp_log'
+SPEC = re.compile(r'%([-0]*)(\d*)([duxbc%])')
+ARG_SIZE = {'d': 4, 'u': 4, 'x': 4, 'b': 4, 'c': 1}
+
+
+def read_section(path, name):
+    with open(path, 'rb') as f:
+        elf = f.read()
+    if elf[:4] != b'\x7fELF' or elf[5] != 1:
+        sys.exit('%s: not a little-endian ELF file' % path)
+    if elf[4] == 1:
+        shoff, = struct.unpack_from('<I', elf, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x2E)
+        header = '<IIIIIIIIII'
+    else:
+        shoff, = struct.unpack_from('<Q', elf, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from('<HHH', elf, 0x3A)
+        header = '<IIQQQQIIQQ'
+    sections = [struct.unpack_from(header, elf, shoff + i * shentsize) for i in range(shnum)]
+    names = sections[shstrndx][4]
+    for sh_name, _, _, _, sh_offset, sh_size, _, _, _, _ in sections:
+        end = elf.index(b'\0', names + sh_name)
+        if elf[names + sh_name:end].decode() == name:
+            return elf[sh_offset:sh_offset + sh_size]
+    sys.exit('%s: no %s section' % (path, name))
+
+
+def convert(conv, raw):
+    if conv == 'c':
+        return chr(raw[0])
+    value, = struct.unpack('<I', raw)
+    if conv == 'd':
+        return str(value - (1 << 32) if value & 0x80000000 else value)
+    if conv == 'x':
+        return '%x' % value
+    if conv == 'b':
+        return bin(value)[2:]
+    return str(value)
+
+
+def pad(text, flags, width, conv):
+    width = int(width or 0)
+    if len(text) >= width:
+        return text
+    if '-' in flags:
+        return text.ljust(width)
+    if '0' in flags and conv != 'c':
+        sign = text[0] if text[0] == '-' else ''
+        return sign + text[len(sign):].rjust(width - len(sign), '0')
+    return text.rjust(width)
+
+
+def log_id(text):
+    value = 2166136261
+    for byte in text:
+        value = ((value ^ byte) * 16777619) & 0xFFFFFFFF
+    return value
+
+
+class Decoder:
+    def __init__(self, table):
+        # Template instances and inline functions leave one copy of a string each
+        # A shared ID only matters once a record carries it, the record length is unknown then
+        self.formats = {}
+        self.shared = {}
+        for text in set(table.split(b'\0')[:-1]):
+            record_id = log_id(text)
+            text = text.decode('latin-1')
+            if record_id in self.formats:
+                self.shared.setdefault(record_id, [self.formats[record_id]]).append(text)
+                sys.stderr.write('warning: format strings %r and %r share ID 0x%08x, reword one of them\n'
+                                 % (self.formats[record_id], text, record_id))
+            self.formats[record_id] = text
+
+    def format(self, record_id):
+        if record_id in self.shared:
+            sys.exit('record ID 0x%08x is shared by %s, the rest of the capture is ambiguous'
+                     % (record_id, ' and '.join(repr(text) for text in self.shared[record_id])))
+        if record_id not in self.formats:
+            sys.exit('record ID 0x%08x has no format string in %s, stale ELF?'
+                     % (record_id, SECTION))
+        return self.formats[record_id]
+
+    def decode(self, stream):
+        while True:
+            head = stream.read(4)
+            if len(head) < 4:
+                return
+            fmt = self.format(struct.unpack('<I', head)[0])
+            text = []
+            pos = 0
+            for spec in SPEC.finditer(fmt):
+                text.append(fmt[pos:spec.start()])
+                pos = spec.end()
+                flags, width, conv = spec.groups()
+                if conv == '%':
+                    text.append('%')
+                    continue
+                raw = stream.read(ARG_SIZE[conv])
+                if len(raw) < ARG_SIZE[conv]:
+                    return
+                text.append(pad(convert(conv, raw), flags, width, conv))
+            text.append(fmt[pos:])
+            yield ''.join(text)
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit(__doc__)
+    decoder = Decoder(read_section(sys.argv[1], SECTION))
+    stream = open(sys.argv[2], 'rb') if len(sys.argv) == 3 else sys.stdin.buffer
+    for line in decoder.decode(stream):
+        sys.stdout.write(line)
+
+
+if __name__ == '__main__':
+    main()
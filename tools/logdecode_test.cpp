@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Host check for deferredLog.h and logdecode.py, run by test_logdecode.py.
+//Every call is logged and formatted with Io::Format, the decoded log must match the text.
+//usage: logdecode_test records.bin expected.txt
+
+#include "../deferredLog.h"
+#include <cstdio>
+#include <string>
+
+using namespace Mcucpp;
+
+static FILE* records;
+static std::string expected;
+
+static void WriteRecord(const uint8_t* data, size_t size)
+{
+	fwrite(data, 1, size, records);
+}
+static void WriteText(const uint8_t* data, size_t size)
+{
+	expected.append((const char*)data, size);
+}
+
+static Io::DeferredLog log(WriteRecord);
+static Io::Ostream os(WriteText);
+
+void FromFunction(int16_t t, uint8_t h)
+{
+	IO_LOG(log, "T=%5d H=%x %%|%08b|%c|%-4u|\r\n", t, h, (uint8_t)t, 'q', (unsigned)h * 7u);
+	Io::Format(os, IO_FMT("T=%5d H=%x %%|%08b|%c|%-4u|\r\n"), t, h, (uint8_t)t, 'q', (unsigned)h * 7u);
+}
+
+inline void FromInline(int32_t v)
+{
+	IO_LOG(log, "inline" " %d\r\n", v);
+	Io::Format(os, IO_FMT("inline %d\r\n"), v);
+}
+
+template<typename T>
+void FromTemplate(T v)
+{
+	IO_LOG(log, "template %u/%x\r\n", v, v);
+	Io::Format(os, IO_FMT("template %u/%x\r\n"), v, v);
+}
+
+template<typename Log>
+void FromDependent(Log& dlog, char c)
+{
+	IO_LOG(dlog, "dependent %c\r\n", c);
+	Io::Format(os, IO_FMT("dependent %c\r\n"), c);
+}
+
+int main(int argc, char* argv[])
+{
+	if(argc != 3)
+		return 2;
+	records = fopen(argv[1], "wb");
+	for(int i = -3; i < 3; ++i)
+	{
+		FromFunction(i * 100 - 5, 0xA0 + i);
+		FromInline(i * 1000);
+		FromTemplate((uint8_t)(i + 200));
+		FromTemplate((uint32_t)i);
+		FromDependent(log, 'a' + i + 3);
+	}
+	IO_LOG(log, "plain\r\n");
+	Io::Format(os, IO_FMT("plain\r\n"));
+	fclose(records);
+	FILE* text = fopen(argv[2], "wb");
+	fwrite(expected.data(), 1, expected.size(), text);
+	fclose(text);
+	return 0;
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Host stand-in for a platform gpio.h: registers are plain variables and every
+//register access is counted in Gpio::accesses, see tools/pinlist_test.cpp
+
+#pragma once
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdint.h>
+
+namespace Mcucpp {
+	namespace Gpio {
+
+		enum OutputConf
+		{
+			OutputSlow,
+			OutputFast
+		};
+		enum OutputMode
+		{
+			PushPull,
+			OpenDrain
+		};
+		enum InputConf
+		{
+			Input,
+			Analog
+		};
+		enum InputMode
+		{
+			Floating,
+			PullUp
+		};
+
+		struct Accesses
+		{
+			int reads, odrReads, writes, configs;
+		};
+		//Defined by the test program
+		extern Accesses accesses;
+
+		template<int id>
+		struct Port
+		{
+			static uint32_t odr, idr, outputMask;
+			static uint32_t Read()
+			{
+				++accesses.reads;
+				return idr;
+			}
+			static uint32_t ReadODR()
+			{
+				++accesses.odrReads;
+				return odr;
+			}
+			static void ClearAndSet(uint32_t clearMask, uint32_t setMask)
+			{
+				++accesses.writes;
+				odr = (odr & ~clearMask) | setMask;
+			}
+			template<uint32_t mask, OutputConf conf, OutputMode mode>
+			static void SetConfig()
+			{
+				++accesses.configs;
+				outputMask |= mask;
+			}
+			template<uint32_t mask, InputConf conf, InputMode mode>
+			static void SetConfig()
+			{
+				++accesses.configs;
+				outputMask &= ~mask;
+			}
+		};
+		template<int id>
+		uint32_t Port<id>::odr;
+		template<int id>
+		uint32_t Port<id>::idr;
+		template<int id>
+		uint32_t Port<id>::outputMask;
+
+		template<typename P, uint8_t pos>
+		struct Pin
+		{
+			using Port = P;
+			enum { position = pos };
+			static bool IsSet()
+			{
+				++accesses.reads;
+				return P::idr >> pos & 1;
+			}
+			static bool IsSetODR()
+			{
+				++accesses.odrReads;
+				return P::odr >> pos & 1;
+			}
+			static void SetOrClear(bool value)
+			{
+				++accesses.writes;
+				P::odr = value ? P::odr | 1UL << pos : P::odr & ~(1UL << pos);
+			}
+			template<OutputConf conf, OutputMode mode>
+			static void SetConfig()
+			{
+				P::template SetConfig<1UL << pos, conf, mode>();
+			}
+			template<InputConf conf, InputMode mode>
+			static void SetConfig()
+			{
+				P::template SetConfig<1UL << pos, conf, mode>();
+			}
+		};
+
+	}//Gpio
+}//Mcucpp
+
+#endif // GPIO_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//MpmcQueue scaling with 1 to N producer threads and one consumer, against a
+//CircularBuffer behind a mutex, see bench.py
+
+#include "../mpmcQueue.h"
+#include "../circularBuffer.h"
+#include "bench.h"
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum { Count = 1 << 22, MaxProducers = 8 };
+
+static const bool shareCore = std::thread::hardware_concurrency() < 2;
+
+static void Idle()
+{
+	if(shareCore)
+		std::this_thread::yield();
+}
+
+static MpmcQueue<4096, uint32_t> queue;
+
+//The reference: the same ring with every access under one lock
+struct Locked
+{
+	static CircularBuffer<4096, uint32_t> buffer;
+	static std::mutex lock;
+	bool Write(uint32_t value)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return buffer.Write(value);
+	}
+	bool Read(uint32_t& value)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		return buffer.Read(value);
+	}
+};
+CircularBuffer<4096, uint32_t> Locked::buffer;
+std::mutex Locked::lock;
+static Locked locked;
+
+static bool ordered = true;
+
+//Values carry the producer number in the top byte, each producer's values must stay in order
+template<typename Q>
+void Run(Q& q, unsigned producers)
+{
+	const uint32_t share = Count / producers;
+	std::vector<std::thread> threads;
+	for(uint32_t p = 0; p < producers; ++p)
+	{
+		threads.emplace_back([&q, p, share]
+		{
+			for(uint32_t i = 0; i < share; )
+			{
+				if(q.Write(p << 24 | i))
+					++i;
+				else
+					Idle();
+			}
+		});
+	}
+	uint32_t next[MaxProducers] = {};
+	uint32_t value;
+	for(uint32_t n = 0; n < share * producers; )
+	{
+		if(q.Read(value))
+		{
+			ordered &= (value & 0xFFFFFF) == next[value >> 24]++;
+			++n;
+		}
+		else
+			Idle();
+	}
+	for(auto& t : threads)
+		t.join();
+}
+
+int main()
+{
+	if(shareCore)
+		puts("single core: threads yield while waiting, no parallel speedup is possible");
+	for(unsigned producers = 1; producers <= MaxProducers; producers *= 2)
+	{
+		const double lockFree = Bench::Best([producers] { Run(queue, producers); }, 3);
+		const double lock = Bench::Best([producers] { Run(locked, producers); }, 3);
+		printf("%u producer%s: MpmcQueue %6.1f M/s, locked CircularBuffer %6.1f M/s\n", producers,
+				producers == 1 ? " " : "s", Count / lockFree / 1e6, Count / lock / 1e6);
+	}
+	if(!ordered)
+		puts("values of a producer arrived out of order");
+	return !ordered;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Host checks for pinlist.h against the register mock in tools/mock/gpio.h,
+//run by test_pinlist.py. Each list is compared with the per-pin reference
+//(one SetOrClear or IsSet per pin) and its register accesses are counted
+
+#include "../pinlist.h"
+#include <cstdio>
+
+using namespace Mcucpp::Gpio;
+
+namespace Mcucpp { namespace Gpio { Accesses accesses; } }
+
+static int failures;
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); ++failures; } } while(0)
+
+typedef Port<0> PA;
+typedef Port<1> PB;
+typedef Port<2> PC;
+
+static uint64_t seed = 1;
+static uint64_t Random()
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 7;
+	seed ^= seed << 17;
+	return seed;
+}
+
+template<unsigned index, typename... Pins>
+struct PerPin
+{
+	static void Write(uint64_t){}
+	static uint64_t Read()
+	{ return 0; }
+	static uint64_t ReadODR()
+	{ return 0; }
+};
+template<unsigned index, typename First, typename... Rest>
+struct PerPin<index, First, Rest...>
+{
+	using Next = PerPin<index + 1, Rest...>;
+	static void Write(uint64_t value)
+	{
+		First::SetOrClear(value >> index & 1);
+		Next::Write(value);
+	}
+	static uint64_t Read()
+	{
+		return (uint64_t)First::IsSet() << index | Next::Read();
+	}
+	static uint64_t ReadODR()
+	{
+		return (uint64_t)First::IsSetODR() << index | Next::ReadODR();
+	}
+};
+
+template<typename List>
+struct Length;
+template<typename... Ts>
+struct Length<Private::TypeList<Ts...>>
+{
+	enum { value = sizeof...(Ts) };
+};
+
+//Shift-and-mask steps a Write or Read takes on one port of the list
+template<typename Port, typename... Pins>
+struct DeltaGroupCount
+{
+	using Indexed = typename Private::IndexPins<0, Pins...>::type;
+	enum { value = Length<typename Private::UniqueDeltas<typename Private::PinsOfPort<Port, Indexed>::type>::type>::value };
+};
+
+static void RandomizeRegisters()
+{
+	PA::odr = (uint32_t)Random();
+	PB::odr = (uint32_t)Random();
+	PC::odr = (uint32_t)Random();
+	PA::idr = (uint32_t)Random();
+	PB::idr = (uint32_t)Random();
+	PC::idr = (uint32_t)Random();
+}
+
+//Same register contents and values as the per-pin reference, with one access per port
+template<int ports, typename... Pins>
+void RoundTrip()
+{
+	typedef Pinlist<Pins...> List;
+	typedef PerPin<0, Pins...> Reference;
+	typedef typename List::value_type T;
+	const uint64_t all = sizeof...(Pins) < 64 ? (1ULL << sizeof...(Pins)) - 1 : ~0ULL;
+	for(int i = 0; i < 10000; ++i)
+	{
+		RandomizeRegisters();
+		const uint32_t odr[3] = { PA::odr, PB::odr, PC::odr };
+		const T value = (T)(Random() & all);
+		Reference::Write(value);
+		const uint32_t expected[3] = { PA::odr, PB::odr, PC::odr };
+		PA::odr = odr[0];
+		PB::odr = odr[1];
+		PC::odr = odr[2];
+		accesses = Accesses();
+		List::Write(value);
+		CHECK(accesses.writes == ports);
+		CHECK(PA::odr == expected[0] && PB::odr == expected[1] && PC::odr == expected[2]);
+
+		accesses = Accesses();
+		CHECK(List::ReadODR() == value);
+		CHECK(accesses.odrReads == ports);
+
+		const T sample = (T)Reference::Read();
+		accesses = Accesses();
+		CHECK(List::Read() == sample);
+		CHECK(accesses.reads == ports);
+		if(failures)
+			return;
+	}
+}
+
+template<int ports, typename... Pins>
+void Configure()
+{
+	typedef Pinlist<Pins...> List;
+	typedef PerPin<0, Pins...> Reference;
+	PA::outputMask = PB::outputMask = PC::outputMask = 0;
+	accesses = Accesses();
+	List::template SetConfig<OutputFast, PushPull>();
+	CHECK(accesses.configs == ports);
+	//every pin is an output now: writing all ones sets exactly the listed pins
+	PA::odr = PB::odr = PC::odr = 0;
+	Reference::Write(~0ULL);
+	CHECK(PA::outputMask == PA::odr && PB::outputMask == PB::odr && PC::outputMask == PC::odr);
+	accesses = Accesses();
+	List::template SetConfig<Input, PullUp>();
+	CHECK(accesses.configs == ports);
+	CHECK(PA::outputMask == 0 && PB::outputMask == 0 && PC::outputMask == 0);
+}
+
+//A 16-pin bus over two ports with pins out of order
+#define BUS Pin<PA, 0>, Pin<PA, 1>, Pin<PA, 2>, Pin<PA, 3>, Pin<PB, 7>, Pin<PB, 8>, Pin<PB, 9>, Pin<PA, 8>, \
+			Pin<PA, 9>, Pin<PA, 10>, Pin<PB, 0>, Pin<PA, 15>, Pin<PB, 1>, Pin<PB, 2>, Pin<PA, 4>, Pin<PA, 5>
+//48 pins spread over three ports
+#define WIDE_ROW(p) Pin<p, 0>, Pin<p, 5>, Pin<p, 1>, Pin<p, 2>, Pin<p, 9>, Pin<p, 10>, Pin<p, 11>, Pin<p, 3>, \
+			Pin<p, 15>, Pin<p, 14>, Pin<p, 4>, Pin<p, 6>, Pin<p, 7>, Pin<p, 8>, Pin<p, 12>, Pin<p, 13>
+#define WIDE WIDE_ROW(PA), WIDE_ROW(PB), WIDE_ROW(PC)
+//Bits 0 and 40 on the same port, 32 or more value positions apart
+#define SPAN Pin<PC, 0>, Pin<PA, 1>, Pin<PA, 2>, Pin<PA, 3>, Pin<PA, 4>, Pin<PA, 5>, Pin<PA, 6>, Pin<PA, 7>, \
+			Pin<PA, 8>, Pin<PA, 9>, Pin<PA, 10>, Pin<PA, 11>, Pin<PA, 12>, Pin<PA, 13>, Pin<PA, 14>, Pin<PA, 15>, \
+			Pin<PB, 0>, Pin<PB, 1>, Pin<PB, 2>, Pin<PB, 3>, Pin<PB, 4>, Pin<PB, 5>, Pin<PB, 6>, Pin<PB, 7>, \
+			Pin<PB, 8>, Pin<PB, 9>, Pin<PB, 10>, Pin<PB, 11>, Pin<PB, 12>, Pin<PB, 13>, Pin<PB, 14>, Pin<PB, 15>, \
+			Pin<PB, 16>, Pin<PB, 17>, Pin<PB, 18>, Pin<PB, 19>, Pin<PB, 20>, Pin<PB, 21>, Pin<PB, 22>, Pin<PB, 23>, Pin<PC, 9>
+#define NARROW Pin<PA, 3>, Pin<PA, 4>, Pin<PB, 0>
+
+static_assert(DeltaGroupCount<PA, BUS>::value == 4 && DeltaGroupCount<PB, BUS>::value == 3,
+			"the bus takes 7 shift-and-mask steps instead of 16 single bits");
+static_assert(std::is_same<Pinlist<BUS>::value_type, uint16_t>::value, "");
+static_assert(std::is_same<Pinlist<WIDE>::value_type, uint64_t>::value, "");
+static_assert(std::is_same<Pinlist<NARROW>::value_type, uint8_t>::value, "");
+static_assert(std::is_same<Pinlist<Pin<PA, 0>, SequenceOf<12> >::value_type, uint16_t>::value, "");
+
+void Sequence()
+{
+	typedef Pinlist<Pin<PC, 3>, SequenceOf<5> > Seq;
+	PC::odr = 0xFFFF0000;
+	accesses = Accesses();
+	Seq::Write(0x15);
+	CHECK(accesses.writes == 1);
+	CHECK(PC::odr == (0xFFFF0000 | 0x15 << 3));
+	CHECK(Seq::ReadODR() == 0x15);
+}
+
+int main()
+{
+	RoundTrip<2, BUS>();
+	RoundTrip<3, WIDE>();
+	RoundTrip<3, SPAN>();
+	RoundTrip<2, NARROW>();
+	Configure<2, BUS>();
+	Configure<3, WIDE>();
+	Sequence();
+	return failures != 0;
+}
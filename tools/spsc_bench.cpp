@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Two-thread SPSC throughput and latency, VolatileIndex against AtomicIndex, see bench.py.
+//VolatileIndex is meant for an ISR and the main loop on one core; across host threads
+//it only runs correctly on a strongly ordered CPU such as x86, so the figures compare
+//the cost of the index traffic rather than vouch for it on weakly ordered ones
+
+#include "../circularBuffer.h"
+#include "bench.h"
+#include <thread>
+
+using Mcucpp::Ring::VolatileIndex;
+using Mcucpp::Ring::AtomicIndex;
+
+enum { Count = 1 << 24, Chunk = 64, RoundTrips = 1 << 18 };
+
+template<typename Sync>
+struct Queues
+{
+	static CircularBuffer<4096, uint32_t, Sync> data, ping, pong;
+};
+template<typename Sync>
+CircularBuffer<4096, uint32_t, Sync> Queues<Sync>::data;
+template<typename Sync>
+CircularBuffer<4096, uint32_t, Sync> Queues<Sync>::ping;
+template<typename Sync>
+CircularBuffer<4096, uint32_t, Sync> Queues<Sync>::pong;
+
+static bool ordered = true;
+//On a single core a spinning thread only burns the time slice the other one needs
+static const bool shareCore = std::thread::hardware_concurrency() < 2;
+
+static void Idle()
+{
+	if(shareCore)
+		std::this_thread::yield();
+}
+
+template<typename Sync>
+void PerElement()
+{
+	auto& q = Queues<Sync>::data;
+	std::thread consumer([&q]
+	{
+		uint32_t value;
+		for(uint32_t expected = 0; expected < Count; )
+		{
+			if(q.Read(value))
+				ordered &= value == expected++;
+			else
+				Idle();
+		}
+	});
+	for(uint32_t i = 0; i < Count; )
+	{
+		if(q.Write(i))
+			++i;
+		else
+			Idle();
+	}
+	consumer.join();
+}
+
+template<typename Sync>
+void Bulk()
+{
+	auto& q = Queues<Sync>::data;
+	std::thread consumer([&q]
+	{
+		uint32_t block[Chunk];
+		for(uint32_t expected = 0; expected < Count; )
+		{
+			const size_t n = q.Read(block, Chunk);
+			if(!n)
+				Idle();
+			for(size_t i = 0; i < n; ++i)
+				ordered &= block[i] == expected++;
+		}
+	});
+	uint32_t block[Chunk];
+	for(uint32_t i = 0; i < Count; )
+	{
+		for(uint32_t k = 0; k < Chunk; ++k)
+			block[k] = i + k;
+		const size_t n = q.Write(block, Chunk);
+		if(!n)
+			Idle();
+		i += n;
+	}
+	consumer.join();
+}
+
+//One value bounces between the threads, a round trip is two hand-overs
+template<typename Sync>
+void PingPong()
+{
+	auto& ping = Queues<Sync>::ping;
+	auto& pong = Queues<Sync>::pong;
+	std::thread echo([&ping, &pong]
+	{
+		uint32_t value;
+		for(int i = 0; i < RoundTrips; ++i)
+		{
+			while(!ping.Read(value))
+				Idle();
+			pong.Write(value);
+		}
+	});
+	uint32_t value;
+	for(int i = 0; i < RoundTrips; ++i)
+	{
+		ping.Write((uint32_t)i);
+		while(!pong.Read(value))
+			Idle();
+		ordered &= value == (uint32_t)i;
+	}
+	echo.join();
+}
+
+template<typename Sync>
+void Run(const char* name)
+{
+	const double perElement = Bench::Best(PerElement<Sync>);
+	const double bulk = Bench::Best(Bulk<Sync>);
+	const double pingPong = Bench::Best(PingPong<Sync>);
+	printf("%-14s per element %6.1f M/s, bulk of %d %6.1f M/s, hand-over %5.0f ns\n", name,
+			Count / perElement / 1e6, Chunk, Count / bulk / 1e6, pingPong / RoundTrips / 2 * 1e9);
+}
+
+int main()
+{
+	if(shareCore)
+		puts("single core: threads yield while waiting, hand-over times are scheduler bound");
+	Run<VolatileIndex>("VolatileIndex");
+	Run<AtomicIndex<> >("AtomicIndex");
+	if(!ordered)
+		puts("values arrived out of order");
+	return !ordered;
+}
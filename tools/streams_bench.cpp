@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Each numeric path of Ostream against snprintf, see bench.py. Every value
+//printed is also checked against the snprintf text
+
+#include "../streams.h"
+#include "bench.h"
+#include <cinttypes>
+#include <cstring>
+
+using namespace Mcucpp;
+
+enum { Values = 1 << 18 };
+
+static uint64_t values[Values];
+static char text[32];
+static size_t textLength;
+static bool equal = true;
+
+static void Sink(const uint8_t* data, size_t length)
+{
+	memcpy(text, data, length);
+	textLength = length;
+}
+
+static Io::Ostream os(Sink);
+
+//snprintf text of a value, the reference for one Ostream path
+template<typename T>
+struct Printf
+{
+	const char* format;
+	int operator()(char* buf, size_t size, T value) const
+	{
+		return snprintf(buf, size, format, value);
+	}
+};
+//Fixed-point with three fractional digits
+template<typename T>
+struct PrintfPoint
+{
+	const char* format;
+	int operator()(char* buf, size_t size, T value) const
+	{
+		return snprintf(buf, size, format, value / 1000, (unsigned)(value % 1000));
+	}
+};
+
+//Same values, same text, with Ostream and with snprintf
+template<typename T, typename Ref>
+void Run(const char* type, Ref ref)
+{
+	const double stream = Bench::Best([]
+	{
+		for(uint64_t value : values)
+			os << (T)value;
+		Bench::Keep(text);
+	}) / Values * 1e9;
+	const double reference = Bench::Best([ref]
+	{
+		for(uint64_t value : values)
+			Bench::Keep(ref(text, sizeof(text), (T)value));
+	}) / Values * 1e9;
+	for(uint64_t value : values)
+	{
+		os << (T)value;
+		char expected[32];
+		const int length = ref(expected, sizeof(expected), (T)value);
+		equal &= textLength == (size_t)length && !memcmp(text, expected, length);
+	}
+	printf("%-8s %-22s Ostream %5.1f ns, snprintf %5.1f ns\n", type, ref.format, stream, reference);
+}
+
+//Mostly short numbers with some up to the full width
+static void Fill(int bits)
+{
+	uint64_t seed = 1;
+	for(uint64_t& value : values)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		value = seed >> (64 - bits) >> (seed % bits);
+	}
+}
+
+int main()
+{
+	os.SetFieldWidth(0);
+	Fill(32);
+	Run<int32_t>("int32_t", Printf<int32_t>{"%" PRId32});
+	Run<uint32_t>("uint32_t", Printf<uint32_t>{"%" PRIu32});
+	os.SetPoint(3);
+	Run<uint32_t>("uint32_t", PrintfPoint<uint32_t>{"%" PRIu32 ".%03u"});
+	os.SetPoint(0);
+	Fill(64);
+	Run<int64_t>("int64_t", Printf<int64_t>{"%" PRId64});
+	Run<uint64_t>("uint64_t", Printf<uint64_t>{"%" PRIu64});
+	os.SetPoint(3);
+	Run<uint64_t>("uint64_t", PrintfPoint<uint64_t>{"%" PRIu64 ".%03u"});
+	os.SetPoint(0);
+	os.SetSystem(Io::System::hex);
+	Fill(32);
+	Run<uint32_t>("uint32_t", Printf<uint32_t>{"0x%" PRIx32});
+	Fill(64);
+	Run<uint64_t>("uint64_t", Printf<uint64_t>{"0x%" PRIx64});
+	if(!equal)
+		puts("Ostream output differs from snprintf");
+	return !equal;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Host checks for stringUtils.cpp against plain byte loops, run by test_stringUtils.py.
+//Strings get random lengths, contents and alignments, every one in its own heap block
+//so that the byte loops around the kernels run under ASan at the exact string end.
+
+#include "../stringUtils.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Mcucpp::Io;
+
+static int failures;
+#define CHECK(cond) do { if(!(cond)) { printf("%s:%d: CHECK(%s) failed, string %d\n", __FILE__, __LINE__, #cond, iteration); ++failures; } } while(0)
+
+static int iteration;
+static uint32_t seed = 1;
+static uint32_t Random(uint32_t range)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed % range;
+}
+
+static uint8_t RefLower(uint8_t ch)
+{
+	return ch >= 'A' && ch <= 'Z' ? ch + 0x20 : ch;
+}
+static uint8_t RefUpper(uint8_t ch)
+{
+	return ch >= 'a' && ch <= 'z' ? ch - 0x20 : ch;
+}
+static int Sign(int x)
+{
+	return (x > 0) - (x < 0);
+}
+
+//Mostly letters and their neighbours in ASCII, some bytes above 0x7F
+static void Fill(uint8_t* str, size_t length)
+{
+	static const char edges[] = "aAzZ@[`{ mQ";
+	for(size_t i = 0; i < length; ++i)
+		str[i] = Random(5) ? edges[Random(sizeof(edges) - 1)] : Random(255) + 1;
+	str[length] = '\0';
+}
+
+static void CheckOne()
+{
+	const size_t length = Random(4) ? Random(40) : Random(300);
+	const size_t offset = Random(32), offset2 = Random(32);
+	uint8_t* block = (uint8_t*)malloc(offset + length + 1);
+	uint8_t* block2 = (uint8_t*)malloc(offset2 + length + 1);
+	uint8_t* ref = (uint8_t*)malloc(length + 1);
+	uint8_t* const str = block + offset;
+	uint8_t* const str2 = block2 + offset2;
+	Fill(str, length);
+
+	CHECK(str_length(str) == length);
+
+	memcpy(str2, str, length + 1);
+	if(length && Random(2))
+		str2[Random(length)] = Random(255) + 1;
+	if(length && Random(4) == 0)
+		str2[Random(length)] = '\0';
+	for(size_t i = 0; i < length; ++i)
+	{
+		if(Random(2))
+			str2[i] = Random(2) ? RefLower(str2[i]) : RefUpper(str2[i]);
+	}
+	int expected = 0;
+	for(size_t i = 0;; ++i)
+	{
+		const int ch1 = RefLower(str[i]), ch2 = RefLower(str2[i]);
+		if(ch1 != ch2 || !ch1)
+		{
+			expected = ch1 - ch2;
+			break;
+		}
+	}
+	CHECK(Sign(str_casecmp(str, str2)) == Sign(expected));
+	CHECK(Sign(str_casecmp(str2, str)) == -Sign(expected));
+
+	for(size_t i = 0; i <= length; ++i)
+		ref[i] = RefLower(str[i]);
+	CHECK(to_lower(str) == str && !memcmp(str, ref, length + 1));
+	for(size_t i = 0; i <= length; ++i)
+		ref[i] = RefUpper(str[i]);
+	CHECK(to_upper(str) == str && !memcmp(str, ref, length + 1));
+
+	free(block);
+	free(block2);
+	free(ref);
+}
+
+int main()
+{
+	for(; iteration < 100000 && failures < 10; ++iteration)
+		CheckOne();
+	return failures != 0;
+}
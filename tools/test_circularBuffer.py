@@ -0,0 +1,55 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Dmytro Shestakov
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""Host test for circularBuffer.h: builds circularBuffer_test.cpp with ASan and UBSan.
+
+usage: test_circularBuffer.py    (CXX selects the compiler, c++ by default)
+"""
+
+import unittest
+
+import hosttest
+
+SOURCES = ['tools/circularBuffer_test.cpp']
+SANITIZE = ['-g', '-fsanitize=address,undefined', '-fno-sanitize-recover=all']
+
+
+class CircularBufferTest(unittest.TestCase):
+    def check(self, *flags):
+        status, output = hosttest.run(SOURCES, SANITIZE + list(flags))
+        self.assertEqual(status, 0, output)
+
+    def test_optimized(self):
+        self.check('-O2')
+
+    def test_unoptimized(self):
+        self.check('-O0')
+
+    def test_words(self):
+        self.check('-O2', '-DMCUCPP_NO_SIMD')
+
+    def test_words_unoptimized(self):
+        self.check('-O0', '-DMCUCPP_NO_SIMD')
+
+
+if __name__ == '__main__':
+    unittest.main()
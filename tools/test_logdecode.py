@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Dmytro Shestakov
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+"""Host test for deferredLog.h and logdecode.py: builds logdecode_test.cpp, which logs
+from a plain function, an inline function and function templates, and checks that the
+decoded capture matches Io::Format output for the same calls.
+
+usage: test_logdecode.py    (CXX selects the compiler, c++ by default)
+"""
+
+import io
+import os
+import subprocess
+import tempfile
+import unittest
+from unittest import mock
+
+import hosttest
+import logdecode
+
+SOURCES = ['tools/logdecode_test.cpp', 'streams.cpp', 'utils.cpp', 'stringUtils.cpp']
+
+
+class LogDecodeTest(unittest.TestCase):
+    def build_and_run(self, *flags, std='c++11'):
+        with tempfile.TemporaryDirectory() as tmp:
+            exe = os.path.join(tmp, 'logdecode_test')
+            records = os.path.join(tmp, 'records.bin')
+            expected = os.path.join(tmp, 'expected.txt')
+            hosttest.build(exe, SOURCES, flags, std)
+            subprocess.check_call([exe, records, expected])
+            decoder = logdecode.Decoder(logdecode.read_section(exe, logdecode.SECTION))
+            with open(records, 'rb') as f:
+                decoded = ''.join(decoder.decode(f))
+            with open(expected, 'rb') as f:
+                self.assertEqual(decoded, f.read().decode('latin-1'))
+            unknown = next(i for i in range(0x10000) if i not in decoder.formats)
+            with self.assertRaises(SystemExit):
+                list(decoder.decode(io.BytesIO(unknown.to_bytes(4, 'little'))))
+
+    def test_default(self):
+        self.build_and_run('-O2')
+
+    def test_unoptimized(self):
+        self.build_and_run('-O0')
+
+    def test_lto(self):
+        self.build_and_run('-Os', '-flto')
+
+    def test_cpp20(self):
+        self.build_and_run('-O2', '-Werror', std='c++20')
+
+    def test_shared_id(self):
+        # Equal length strings share an ID here, only their records fail to decode
+        with mock.patch.object(logdecode, 'log_id', len), mock.patch('sys.stderr'):
+            decoder = logdecode.Decoder(b'a=%d\0b=%d\0ok %c\0')
+        self.assertEqual(list(decoder.decode(io.BytesIO(b'\5\0\0\0!'))), ['ok !'])
+        with self.assertRaises(SystemExit):
+            list(decoder.decode(io.BytesIO(b'\4\0\0\0\0\0\0\0')))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Host simulation of a TxChannel drain, see bench.py: main-loop time spent logging
+//to a polled UART against TxChannel with each overflow policy. A one-shot
+//interval timer stands in for the UART, its signal handler is the
+//transfer complete interrupt and preempts the main loop like an ISR would
+
+#include "../txChannel.h"
+#include "bench.h"
+#include <signal.h>
+#include <sys/time.h>
+
+using namespace Mcucpp;
+
+enum { Baud = 115200, Lines = 200 };
+static const double byteTime = 10.0 / Baud;
+
+//What reached the wire
+static uint8_t wire[Lines * 64];
+static volatile size_t wireLength;
+//The polled run's output, a channel that loses nothing must send the same
+static uint8_t reference[sizeof(wire)];
+static bool intact = true;
+
+static const uint8_t* volatile txData;
+static volatile size_t txLength;
+
+struct Uart
+{
+	static void Transmit(const uint8_t* data, size_t length)
+	{
+		txData = data;
+		txLength = length;
+		const long us = (long)(length * byteTime * 1e6) + 1;
+		itimerval timer = {{0, 0}, {us / 1000000, us % 1000000}};
+		setitimer(ITIMER_REAL, &timer, nullptr);
+	}
+};
+
+//Each policy gets its own channel, a Hw type per channel
+template<int n>
+struct Hw : Uart {};
+
+static void (*txDone)();
+
+static void OnTimer(int)
+{
+	memcpy(wire + wireLength, (const void*)txData, txLength);
+	wireLength += txLength;
+	txDone();
+}
+
+static void Spin(double seconds)
+{
+	const double end = Bench::Now() + seconds;
+	while(Bench::Now() < end) { }
+}
+
+//Polled UART: each char waits for the shift register, nothing is lost
+static void PutPolled(uint8_t ch)
+{
+	Spin(byteTime);
+	wire[wireLength++] = ch;
+}
+
+//Main loop: some work, then a log line. Returns seconds spent in the loop
+static double MainLoop(Io::Ostream& os, double work)
+{
+	wireLength = 0;
+	os.SetFieldWidth(0);
+	const double start = Bench::Now();
+	for(uint32_t i = 0; i < Lines; ++i)
+	{
+		Spin(work);
+		os << "tick " << i << " adc " << i * 37 % 4096 << Io::endl;
+	}
+	return Bench::Now() - start;
+}
+
+template<typename Channel>
+void Async(const char* name, double work, double polled, size_t total)
+{
+	txDone = Channel::OnTxDone;
+	Io::Ostream os(Channel::Write);
+	const double loop = MainLoop(os, work);
+	while(!Channel::IsIdle()) { }
+	if(wireLength == total)
+		intact &= !memcmp(wire, reference, total);
+	printf("  %-22s main loop %6.1f ms, %4.1f%% saved, %4u of %4u bytes sent\n", name, loop * 1e3,
+			(polled - loop) / polled * 100, (unsigned)wireLength, (unsigned)total);
+}
+
+static void Scenario(const char* title, double work)
+{
+	printf("%s, %.1f ms of work per line:\n", title, work * 1e3);
+	Io::Ostream polledStream(PutPolled);
+	const double polled = MainLoop(polledStream, work);
+	const size_t total = wireLength;
+	memcpy(reference, wire, total);
+	printf("  %-22s main loop %6.1f ms, %4u bytes sent\n", "polled UART", polled * 1e3, (unsigned)total);
+	Async<Io::TxChannel<Hw<0>, 256, Io::TxOverflow::Block> >("TxChannel Block", work, polled, total);
+	Async<Io::TxChannel<Hw<1>, 256, Io::TxOverflow::Drop> >("TxChannel Drop", work, polled, total);
+	Async<Io::TxChannel<Hw<2>, 256, Io::TxOverflow::Truncate<'~'> > >("TxChannel Truncate", work, polled, total);
+}
+
+int main()
+{
+	signal(SIGALRM, OnTimer);
+	printf("%u baud, %u lines of about 20 bytes\n", (unsigned)Baud, (unsigned)Lines);
+	Scenario("UART keeps up", 3e-3);
+	Scenario("Lines come faster than the UART sends", 0.5e-3);
+	if(!intact)
+		puts("sent text differs from the polled UART output");
+	return !intact;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+//Io::utoa against std::to_chars and the old divide-per-digit loop, see bench.py.
+//Needs C++17 for <charconv>. Every conversion is also checked against std::to_chars
+
+#include "../streams.h"
+#include "bench.h"
+#include <charconv>
+#include <cstring>
+
+using namespace Mcucpp;
+
+enum { Values = 1 << 20, Rounds = 8 };
+
+static uint32_t values[Values];
+static bool equal = true;
+
+//Io::utoa before the two-digit tables: a runtime division by base for every digit
+__attribute__((noinline))
+static uint8_t* DivideLoop(uint32_t value, uint8_t* bufferEnd, uint8_t base)
+{
+	uint8_t* ptr = bufferEnd;
+	do
+	{
+		uint32_t q = value / base;
+		uint32_t rem = value - q * base;
+		value = q;
+		*--ptr = (rem < 10 ? '0' : 'a' - 10) + rem;
+	} while (value != 0);
+	return ptr;
+}
+
+template<uint8_t base>
+struct DivideLoopConverter
+{
+	static size_t Convert(uint32_t value, uint8_t* buf, uint8_t* bufEnd)
+	{
+		uint8_t* str = DivideLoop(value, bufEnd, base);
+		Bench::Keep(buf);
+		return bufEnd - str;
+	}
+};
+
+template<uint8_t base>
+struct UtoaConverter
+{
+	static size_t Convert(uint32_t value, uint8_t* buf, uint8_t* bufEnd)
+	{
+		uint8_t* str = Io::utoa(value, bufEnd, base);
+		Bench::Keep(buf);
+		return bufEnd - str;
+	}
+};
+
+template<uint8_t base>
+struct ToCharsConverter
+{
+	static size_t Convert(uint32_t value, uint8_t* buf, uint8_t* bufEnd)
+	{
+		char* end = std::to_chars((char*)buf, (char*)bufEnd, value, base).ptr;
+		Bench::Keep(buf);
+		return end - (char*)buf;
+	}
+};
+
+template<typename Converter>
+double Measure()
+{
+	return Bench::Best([]
+	{
+		uint8_t buf[16];
+		size_t total = 0;
+		for(int round = 0; round < Rounds; ++round)
+			for(uint32_t value : values)
+				total += Converter::Convert(value, buf, buf + sizeof(buf));
+		Bench::Keep(total);
+	}) / Values / Rounds * 1e9;
+}
+
+template<uint8_t base>
+void Check()
+{
+	for(uint32_t value : values)
+	{
+		uint8_t buf[16], ref[16];
+		const uint8_t* str = Io::utoa(value, buf + sizeof(buf), base);
+		const size_t length = std::to_chars((char*)ref, (char*)ref + sizeof(ref), value, base).ptr - (char*)ref;
+		equal &= (size_t)(buf + sizeof(buf) - str) == length && !memcmp(str, ref, length);
+	}
+}
+
+template<uint8_t base>
+void Run(const char* name)
+{
+	Check<base>();
+	const double divide = Measure<DivideLoopConverter<base> >();
+	const double utoa = Measure<UtoaConverter<base> >();
+	const double toChars = Measure<ToCharsConverter<base> >();
+	printf("%-14s divide per digit %5.1f ns, Io::utoa %5.1f ns, std::to_chars %5.1f ns\n",
+			name, divide, utoa, toChars);
+}
+
+int main()
+{
+	uint32_t seed = 1;
+	for(uint32_t& value : values)
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		value = seed;
+	}
+	Run<10>("dec, 32 bit");
+	Run<16>("hex, 32 bit");
+	//Mostly short numbers, as in counters and sensor readings
+	for(uint32_t& value : values)
+		value >>= value % 32;
+	Run<10>("dec, any size");
+	Run<16>("hex, any size");
+	if(!equal)
+		puts("Io::utoa output differs from std::to_chars");
+	return !equal;
+}
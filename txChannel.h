@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Dmytro Shestakov
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * 
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * 
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#pragma once
+#ifndef TXCHANNEL_H
+#define TXCHANNEL_H
+
+#include "circularBuffer.h"
+#include "streams.h"
+
+namespace Mcucpp {
+	namespace Io {
+
+		//What TxChannel::Write does with a block that doesn't fit
+		namespace TxOverflow {
+			//Wait for the drain to make room. Never write from a context the drain interrupt can't preempt
+			struct Block
+			{
+				template<typename Channel>
+				static void Write(const uint8_t* data, size_t length)
+				{
+					while(length)
+					{
+						const size_t written = Channel::Push(data, length);
+						data += written;
+						length -= written;
+						Channel::Kick();
+					}
+				}
+			};
+			//Discard the whole block rather than a part of it
+			struct Drop
+			{
+				template<typename Channel>
+				static void Write(const uint8_t* data, size_t length)
+				{
+					if(Channel::Free() >= length)
+						Channel::Push(data, length);
+					Channel::Kick();
+				}
+			};
+			//Keep what fits and end it with the marker char
+			template<char marker = '~'>
+			struct Truncate
+			{
+				template<typename Channel>
+				static void Write(const uint8_t* data, size_t length)
+				{
+					const size_t free = Channel::Free();
+					if(free >= length)
+						Channel::Push(data, length);
+					else if(free)
+					{
+						const uint8_t mark = marker;
+						Channel::Push(data, free - 1);
+						Channel::Push(&mark, 1);
+					}
+					Channel::Kick();
+				}
+			};
+		}
+
+		//Ostream sink that queues output and lets an interrupt send it, the main loop never waits
+		//for the UART unless the policy is Block and the ring is full.
+		//Hw::Transmit(const uint8_t* data, size_t length) starts an asynchronous transfer of one
+		//contiguous block (DMA, or a TX-empty interrupt walking the block), its completion
+		//interrupt must call OnTxDone(). Usage:
+		//	typedef Io::TxChannel<Uart1Tx, 256, Io::TxOverflow::Drop> Log;
+		//	Io::Ostream log(Log::Write);
+		template<typename Hw, int SIZE = 128, typename Overflow = TxOverflow::Block>
+		class TxChannel
+		{
+		private:
+			typedef CircularBuffer<SIZE, uint8_t> Buffer;
+			static Buffer buffer_;
+			static volatile size_t inFlight_;
+
+			static void StartNext()
+			{
+				size_t length;
+				const uint8_t* data = buffer_.Peek(length);
+				inFlight_ = length;
+				if(length)
+					Hw::Transmit(data, length);
+			}
+		public:
+			static void Write(const uint8_t* data, size_t length)
+			{
+				Overflow::template Write<TxChannel>(data, length);
+			}
+			//Transfer complete interrupt
+			static void OnTxDone()
+			{
+				buffer_.Consume(inFlight_);
+				StartNext();
+			}
+			static bool IsIdle()
+			{
+				return !inFlight_;
+			}
+
+			//Producer side, used by the overflow policies
+			static size_t Free()
+			{
+				return buffer_.Size() - buffer_.Count();
+			}
+			static size_t Push(const uint8_t* data, size_t length)
+			{
+				return buffer_.Write(data, length);
+			}
+			//Nothing in flight means no completion interrupt is pending, so the drain is restarted here
+			static void Kick()
+			{
+				if(!inFlight_)
+					StartNext();
+			}
+		};
+
+		template<typename Hw, int SIZE, typename Overflow>
+		typename TxChannel<Hw, SIZE, Overflow>::Buffer TxChannel<Hw, SIZE, Overflow>::buffer_;
+		template<typename Hw, int SIZE, typename Overflow>
+		volatile size_t TxChannel<Hw, SIZE, Overflow>::inFlight_;
+
+	}//IO
+}//Mcucpp
+
+#endif // TXCHANNEL_H
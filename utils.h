@@ -109,7 +109,7 @@ namespace Mcucpp
 		{
 			enum
 			{
-				asize = 32,
+				asize = 32 + 1,
 				base = 2
 			};
 		};